@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_assert.h"
+#include "bn_utility.h"
+#include "bn_vector.h"
+
+#include "typedefs.hpp"
+
+#include <new>
+#include <type_traits>
+
+namespace mp
+{
+
+/**
+ * @brief Bump allocator over a single EWRAM block, which is freed as a whole.
+ * Objects created with it are destroyed in reverse order when the arena (or the `Scope`) is released.
+ */
+class Arena final
+{
+public:
+    /**
+     * @brief Max number of non-trivially destructible objects alive in an arena.
+     */
+    static constexpr s32 FINALIZERS_MAX_COUNT = 16;
+
+    /**
+     * @brief Releases everything allocated after its construction, so that the same bytes can be reused.
+     */
+    class Scope final
+    {
+    public:
+        explicit Scope(Arena&);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Arena& _arena;
+        const s32 _usedBytes;
+        const s32 _finalizersCount;
+    };
+
+public:
+    /**
+     * @param name shown on the peak usage report.
+     */
+    Arena(s32 capacity, const char* name);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Allocate uninitialized bytes, which are only freed with the arena or the `Scope`.
+     */
+    [[nodiscard]] void* allocate(s32 bytes, s32 alignment);
+
+    template <typename Type, typename... Args>
+    [[nodiscard]] Type& create(Args&&... args)
+    {
+        void* ptr = allocate(sizeof(Type), alignof(Type));
+        Type* result = ::new (ptr) Type(bn::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<Type>)
+        {
+            BN_ASSERT(!_finalizers.full(), "Arena(", _name, ") finalizers are full");
+            _finalizers.push_back({[](void* object) { static_cast<Type*>(object)->~Type(); }, result});
+        }
+
+        return *result;
+    }
+
+    s32 getCapacity() const;
+    s32 getUsedBytes() const;
+
+    /**
+     * @brief Max bytes used at once, from the arena creation.
+     */
+    s32 getPeakBytes() const;
+
+private:
+    struct Finalizer
+    {
+        void (*destroy)(void* object);
+        void* object;
+    };
+
+private:
+    void _release(s32 usedBytes, s32 finalizersCount);
+
+private:
+    const char* _name;
+    u8* _buffer;
+    const s32 _capacity;
+    s32 _usedBytes = 0;
+    s32 _peakBytes = 0;
+
+    bn::vector<Finalizer, FINALIZERS_MAX_COUNT> _finalizers;
+};
+
+} // namespace mp
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+#include "bn_fixed_point.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_vector.h"
+
+#include "typedefs.hpp"
+
+namespace bn
+{
+class sprite_font;
+}
+
+namespace mp
+{
+
+/**
+ * @brief Digit glyphs `0`~`9` of a font, uploaded to VRAM once.
+ */
+class DigitStrip final
+{
+public:
+    static constexpr s32 DIGITS_COUNT = 10;
+
+public:
+    DigitStrip(const bn::sprite_font&);
+
+    auto getTiles(s32 digit) const -> const bn::sprite_tiles_ptr&;
+    auto getPalette() const -> const bn::sprite_palette_ptr&;
+    auto getShapeSize() const -> const bn::sprite_shape_size&;
+
+    /**
+     * @brief Horizontal advance of a digit, including the character spacing.
+     */
+    s32 getAdvance(s32 digit) const;
+
+private:
+    bn::vector<bn::sprite_tiles_ptr, DIGITS_COUNT> _tiles;
+    bn::sprite_palette_ptr _palette;
+    bn::sprite_shape_size _shapeSize;
+    bn::array<s8, DIGITS_COUNT> _advances;
+};
+
+/**
+ * @brief Right-aligned number text, which consists of one sprite per digit.
+ * Changing the number only swaps the tiles of the digit sprites, without any text generation.
+ */
+class DigitText final
+{
+public:
+    static constexpr s32 MAX_DIGITS = 4;
+
+public:
+    DigitText(const DigitStrip&, const bn::fixed_point& rightPos, s32 bgPriority);
+
+    s32 getNumber() const;
+    void setNumber(s32 number);
+
+    bool isVisible() const;
+    void setVisible(bool isVisible);
+
+private:
+    void _placeDigits(const bn::array<s8, MAX_DIGITS>& digits, s32 digitsCount);
+
+private:
+    const DigitStrip& _strip;
+    const bn::fixed_point _rightPos;
+    const s32 _bgPriority;
+
+    s32 _number = -1;
+    bool _isVisible = false;
+
+    bn::vector<bn::sprite_ptr, MAX_DIGITS> _digitSprites;
+};
+
+} // namespace mp
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+namespace mp::budget
+{
+
+// budgets of the game objects are checked at compile time, see `MemoryBudget.cpp`.
+
+#ifdef MP_DEBUG
+/**
+ * @brief Log every budgeted game object, with its `sizeof` & budget.
+ */
+void logEntries();
+#endif
+
+} // namespace mp::budget
@@ -9,9 +9,11 @@
 #pragma once
 
 #include "bn_array.h"
+#include "bn_optional.h"
 #include "bn_sprite_text_generator.h"
 #include "bn_utility.h"
 
+#include "DigitText.hpp"
 #include "typedefs.hpp"
 
 namespace mp
@@ -32,9 +34,16 @@ public:
     TextGen();
 
     auto get(FontKind) -> bn::sprite_text_generator&;
+    auto getFont(FontKind) const -> const bn::sprite_font&;
+
+    /**
+     * @brief Get the digit glyphs of the font, which are uploaded to VRAM on the first call.
+     */
+    auto getDigitStrip(FontKind) -> const DigitStrip&;
 
 private:
     bn::array<bn::sprite_text_generator, TOTAL_FONTS> _textGens;
+    bn::array<bn::optional<DigitStrip>, TOTAL_FONTS> _digitStrips;
 };
 
 } // namespace mp
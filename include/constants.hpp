@@ -18,6 +18,8 @@ namespace mp::consts
 {
 
 inline constexpr s32 ACTOR_MOVE_FRAMES = 8;
+// while running, with B held.
+inline constexpr s32 ACTOR_RUN_FRAMES = 4;
 
 constexpr bn::fixed_point INIT_CAM_POS = {-8, -8};
 constexpr bn::fixed_point INVENTORY_POS = {16 - bn::display::width() / 2, 144 - bn::display::height() / 2};
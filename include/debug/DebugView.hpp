@@ -18,6 +18,10 @@ namespace mp
 {
 class TextGen;
 }
+namespace mp::scene
+{
+class IScene;
+}
 
 namespace mp::debug
 {
@@ -29,7 +33,10 @@ class DebugView
 public:
     DebugView(TextGen& textGen);
 
-    void update();
+    /**
+     * @param scene current scene, whose arena usage is shown if it has one.
+     */
+    void update(const scene::IScene* scene);
 
 private:
     bool _isVisible() const;
@@ -40,7 +47,7 @@ private:
 private:
     TextGen& _textGen;
     bn::vector<bn::sprite_ptr, 2> _headingSprites;
-    bn::vector<bn::sprite_ptr, 16> _usageSprites;
+    bn::vector<bn::sprite_ptr, 32> _usageSprites;
 
     s32 _updateCounter;
     bn::fixed _lastCpuSum;
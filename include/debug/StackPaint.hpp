@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "typedefs.hpp"
+
+namespace mp::debug
+{
+
+#ifdef MP_DEBUG
+
+/**
+ * @brief Paints the free IWRAM below the stack with a pattern, to find out the deepest stack usage later.
+ */
+class StackPaint final
+{
+public:
+    StackPaint() = delete;
+
+    /**
+     * @brief Paint the free IWRAM, which should be called once, as early as possible on boot.
+     */
+    static void paint();
+
+    /**
+     * @brief Deepest stack usage in bytes since `paint()`, found by the first overwritten word.
+     */
+    static s32 getHighWaterMark();
+};
+
+#endif
+
+} // namespace mp::debug
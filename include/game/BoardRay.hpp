@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "game/BoardPos.hpp"
+#include "typedefs.hpp"
+
+namespace mp::game
+{
+
+/**
+ * @brief Walks the board positions on the line from `from` to `to`, with the Bresenham's line algorithm.
+ * `from` itself is not visited, and `to` is the last one.
+ */
+class BoardRay final
+{
+public:
+    BoardRay(const BoardPos& from, const BoardPos& to);
+
+    bool done() const;
+
+    /**
+     * @brief Step to the next position on the line.
+     */
+    auto next() -> const BoardPos&;
+
+private:
+    BoardPos _pos;
+    const BoardPos _to;
+
+    const s8 _stepX, _stepY;
+    const s16 _dx, _dy;
+    s16 _error;
+};
+
+} // namespace mp::game
@@ -14,13 +14,18 @@
 #include "bn_optional.h"
 
 #include "constants.hpp"
+#include "game/Direction9.hpp"
 #include "game/DungeonBg.hpp"
 #include "game/DungeonFloor.hpp"
 #include "game/Hud.hpp"
+#include "game/MessageLog.hpp"
 #include "game/MiniMap.hpp"
+#include "game/OccupancyBoard.hpp"
+#include "game/TurnScheduler.hpp"
 #include "game/item/Item.hpp"
 #include "game/item/ItemUse.hpp"
 #include "game/mob/Monster.hpp"
+#include "game/mob/MonsterTable.hpp"
 #include "game/mob/Player.hpp"
 #include "scene/SceneType.hpp"
 
@@ -30,6 +35,7 @@ class random;
 }
 namespace mp
 {
+class Arena;
 class TextGen;
 }
 
@@ -39,46 +45,154 @@ namespace mp::game
 class Dungeon final
 {
 public:
-    Dungeon(iso_bn::random& rng, TextGen&, Settings&);
+    /**
+     * @param arena scene arena, which hands out the big buffers & the floor generation scratch.
+     */
+    Dungeon(Arena&, iso_bn::random& rng, TextGen&, Settings&);
 
     [[nodiscard]] auto update() -> bn::optional<scene::SceneType>;
 
     bool isTurnOngoing() const;
 
+    /**
+     * @brief Frames the actors take to move by a tile in this turn, which is shorter while running.
+     */
+    s32 getMoveFrames() const;
+
+private:
+    /**
+     * @brief Player's order read from the keypad, which is latched while the turn is ongoing.
+     */
+    struct Command
+    {
+        enum class Type : u8
+        {
+            NONE,
+            MOVE,
+            // pass the turn, when the player can't act.
+            WAIT,
+            SELECT_NEXT_ITEM,
+            USE_ITEM,
+            TOSS_ITEM,
+        };
+
+        Type type = Type::NONE;
+        Direction9 direction = Direction9::NONE;
+        // move with B held, which keeps moving fast until something interesting shows up.
+        bool isRunning = false;
+    };
+
 private:
     /**
      * @brief Receive user input, and progress a turn.
+     * Input while the turn is ongoing is latched, so that the next turn starts right after the current one.
      *
      * @return `true` if player is still alive after the turn.
      */
     [[nodiscard]] bool _progressTurn();
 
+    /**
+     * @param isLatching read only the newly pressed directions, not the held ones.
+     */
+    auto _readCommand(bool isLatching) const -> Command;
+
+    /**
+     * @return `true` if player is still alive after the turn.
+     */
+    [[nodiscard]] bool _runCommand(const Command&);
+
+    /**
+     * @brief Let monsters act until the player's turn comes again, after the player spent a turn.
+     */
+    void _progressMonsterTurns();
+
+    /**
+     * @brief Spawn a monster, which is also scheduled & stamped onto the mini-map.
+     */
+    void _spawnMonster(mob::MonsterSpecies, const BoardPos&);
+
+    /**
+     * @brief Toss the selected item in the bag to where the player is facing.
+     * It flies up to its toss distance, and stops at a wall or a monster, which it's applied to.
+     * @return `false` if every position on its way already has an item, which leaves it in the bag.
+     */
+    bool _tossSelectedItem();
+
+    /**
+     * @return `nullptr` if there's no item on `pos`.
+     */
+    auto _findItemAt(const BoardPos& pos) const -> const item::Item*;
+
+    /**
+     * @brief Find where to run next, which follows the bend of a corridor.
+     * @return `Direction9::NONE` if the run should stop, as the corridor branched or the room began or ended.
+     */
+    auto _findNextRunDirection(Direction9 runDir) -> Direction9;
+
+    /**
+     * @brief Bitmask of the walkable tiles on the left (bit 0) & right (bit 1) of the run direction.
+     */
+    u8 _getRunSides(const BoardPos& pos, Direction9 runDir) const;
+
+    /**
+     * @brief Check if an item is on or next to the player, or a monster is on the screen.
+     */
+    bool _shouldStopRun() const;
+
     void _startBgScroll(Direction9 moveDir);
     bool _updateBgScroll();
 
-    bool _canMoveTo(const mob::Monster&, const BoardPos& destination) const;
+    /**
+     * @brief Open or close the full-screen map view, which only toggles visibility.
+     */
+    void _setMapViewOpened(bool isOpened);
+
+    bool _canMoveTo(const BoardPos& from, const BoardPos& destination) const;
+
+    /**
+     * @brief Check if a wall blocks the way to the adjacent `destination`, including the diagonal corner.
+     */
+    bool _isBlockedByWall(const BoardPos& from, const BoardPos& destination) const;
 
 #ifdef MP_DEBUG
 private:
     void _testMapGen();
+
+    /**
+     * @brief Profile the benchmarks on the current floor, which is on demand, as they take many frames.
+     */
+    void _runBenchmarks();
 #endif
 
 private:
+    Arena& _arena;
     iso_bn::random& _rng;
     Settings& _settings;
 
     bn::camera_ptr _camera;
     bn::optional<bn::camera_move_to_action> _camMoveAction;
+    Command _latchedCommand;
+
+    s32 _moveFrames = consts::ACTOR_MOVE_FRAMES;
+    // `Direction9::NONE` if the player is not running.
+    Direction9 _runDirection = Direction9::NONE;
+    // walkable sides on the last run step, to detect the branches.
+    u8 _runSides = 0;
 
     DungeonFloor _floor;
     DungeonBg _bg;
     MiniMap _miniMap;
     Hud _hud;
+    MessageLog _log;
     item::ItemUse _itemUse;
 
     mob::Player _player;
-    bn::forward_list<mob::Monster, consts::DUNGEON_MOB_MAX_COUNT> _monsters;
+    mob::MonsterTable _monsters;
+    TurnScheduler _scheduler;
     bn::forward_list<item::Item, consts::DUNGEON_ITEM_MAX_COUNT> _items;
+
+    OccupancyBoard _mobOccupancy;
+    OccupancyBoard _itemOccupancy;
 };
 
 } // namespace mp::game
@@ -8,19 +8,37 @@
 
 #pragma once
 
+#include "bn_array.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_common.h"
 #include "bn_fixed_point.h"
+#include "bn_point.h"
 #include "bn_regular_bg_item.h"
 #include "bn_regular_bg_map_item.h"
 #include "bn_regular_bg_map_ptr.h"
 #include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_vector.h"
 
+#include "constants.hpp"
+#include "game/BoardPos.hpp"
 #include "game/Direction9.hpp"
+#include "game/LightingPalette.hpp"
+#include "game/MetaTileset.hpp"
 #include "typedefs.hpp"
 
 namespace bn
 {
 class camera_ptr;
 }
+namespace mp
+{
+class Arena;
+}
+namespace iso_bn
+{
+class random;
+}
 namespace mp::game::mob
 {
 class Monster;
@@ -30,11 +48,11 @@ namespace mp::game
 {
 
 class DungeonFloor;
-class MetaTileset;
 class ShadowTileset;
 
 /**
  * @brief Manages dungeon background scrolling with tileset.
+ * Shadows are drawn by a blended shadow BG layer, or by darkened palette banks if `MP_PALETTE_LIGHTING` is defined.
  */
 class DungeonBg final
 {
@@ -43,56 +61,224 @@ public:
     static constexpr s32 COLUMNS = 256 / 8;
     static constexpr s32 CELLS_COUNT = ROWS * COLUMNS;
 
+    /**
+     * @brief Max number of dungeon BG tiles in VRAM, which is when every cell of every meta-tile has a different tile.
+     */
+    static constexpr s32 DUN_TILES_COUNT = MetaTile::TILES_COUNT * MetaTile::CELLS_COUNT;
+
+    /**
+     * @brief Number of dungeon BG tiles uploaded to VRAM per frame while loading a meta-tileset.
+     */
+    static constexpr s32 DUN_TILES_UPLOAD_PER_FRAME = 32;
+
+    /**
+     * @brief Cells are double buffered, so that the cells being uploaded to VRAM are never edited in place.
+     */
+    static constexpr s32 CELL_BUFFERS_COUNT = 2;
+
+    /**
+     * @brief Masks the cell hash to pick the variation.
+     */
+    static constexpr u32 VARIANT_MASK = MetaTileset::VARIANTS_COUNT - 1;
+
+    /**
+     * @brief Max number of cells changed in a frame, which is when both a column and a row are redrawn,
+     * on both halves of a scroll that takes only a frame.
+     */
+    static constexpr s32 MAX_DIRTY_CELLS = 2 * (ROWS + COLUMNS);
+
+private:
+    struct TileUpload
+    {
+        u16 srcTileIndex;
+        u16 vramTileIndex;
+    };
+
+    struct CellBuffers
+    {
+        alignas(4) bn::regular_bg_map_cell cells[CELL_BUFFERS_COUNT][CELLS_COUNT];
+    };
+
 private:
     const MetaTileset* _metaTileset;
+#ifndef MP_PALETTE_LIGHTING
     const ShadowTileset& _shadowTileset;
+#endif
 
-    alignas(4) bn::regular_bg_map_cell _dunCells[CELLS_COUNT];
-    alignas(4) bn::regular_bg_map_cell _shadowCells[CELLS_COUNT];
+    // cells of every meta-tile variation, with their tile indexes remapped to the uploaded VRAM tiles.
+    // flattened by `[(metaTileIdx * VARIANTS_COUNT + variant) * CELLS_COUNT + cellIdx]`
+    bn::array<bn::regular_bg_map_cell, DUN_TILES_COUNT * MetaTileset::VARIANTS_COUNT> _metaTileCells;
+    // tiles that are not uploaded to VRAM yet.
+    bn::vector<TileUpload, DUN_TILES_COUNT> _pendingTileUploads;
+
+    // redraws go to the back buffer, and the BG maps are switched to it on `update()`.
+    // these are handed out by the scene arena.
+    bn::regular_bg_map_cell (*const _dunCells)[CELLS_COUNT];
+#ifndef MP_PALETTE_LIGHTING
+    bn::regular_bg_map_cell (*const _shadowCells)[CELLS_COUNT];
+#endif
+    s32 _backCellBufferIdx = 1;
+    // cells changed in the back buffer, which are copied to the other buffer after the swap.
+    bn::vector<u16, MAX_DIRTY_CELLS> _dirtyCellIndexes;
+    bool _allCellsDirty = false;
 
     // dungeon tiles, including walls and floors.
     // this BG also deals with dark (pitch black) undiscovered area.
     bn::regular_bg_map_item _dunMapItem;
-    bn::regular_bg_item _dunBgItem;
+    bn::regular_bg_tiles_ptr _dunTiles;
+#ifdef MP_PALETTE_LIGHTING
+    // every light level of the dungeon palette.
+    LightingPalette::Colors _dunColors;
+#endif
+    bn::bg_palette_ptr _dunPalette;
     bn::regular_bg_ptr _dunBg;
     bn::regular_bg_map_ptr _dunBgMap;
 
+#ifndef MP_PALETTE_LIGHTING
     // dim shadow, with blending enabled.
     bn::regular_bg_map_item _shadowMapItem;
     bn::regular_bg_item _shadowBgItem;
     bn::regular_bg_ptr _shadowBg;
     bn::regular_bg_map_ptr _shadowBgMap;
+#endif
 
-    bool _cellsReloadRequired = false;
+    bool _isVisible = false;
 
     s32 _bgScrollCountdown = 0;
+    s32 _bgScrollFrames = consts::ACTOR_MOVE_FRAMES;
     Direction9 _bgScrollDirection;
+    // camera position when the scroll started.
+    bn::fixed_point _bgScrollStartCamPos;
+    // top-left pixel of the player's meta-tile after the scroll, in camera coordinates.
+    bn::point _bgScrollOrigin;
 
 public:
-    DungeonBg(const bn::camera_ptr&);
+    /**
+     * @param arena scene arena, which hands out the cell buffers.
+     */
+    DungeonBg(const bn::camera_ptr&, MetaTilesetKind, Arena& arena);
 
     void update(const DungeonFloor&, const mob::Monster& player);
 
     void redrawAll(const DungeonFloor&, const mob::Monster& player);
 
-    void startBgScroll(Direction9);
+#ifdef MP_DEBUG
+    /**
+     * @brief Randomized test of the integer camera-cell mapper, against the previous `bn::fixed` functions.
+     */
+    static void testCellMapper(iso_bn::random&);
+
+    /**
+     * @brief Profile `redrawAll()` with the variations, against the single-variant lookup without the cell hash,
+     * which is how the cells were picked before the variations.
+     */
+    void benchmarkVariants(const DungeonFloor&, const mob::Monster& player);
+
+    /**
+     * @brief Profile the scroll redraw of every direction from IWRAM as ARM code, against its ROM (Thumb) build.
+     */
+    void benchmarkScrollRedraw(const DungeonFloor&, const mob::Monster& player);
+#endif
+
+    /**
+     * @param moveFrames frames the camera takes to move by a meta-tile, which is shorter while running.
+     */
+    void startBgScroll(Direction9, s32 moveFrames);
     bool isBgScrollOngoing() const;
 
     bool isVisible() const;
     void setVisible(bool isVisible);
 
-    void setMetaTileset(const MetaTileset&);
+    /**
+     * @brief Switch to the meta-tileset, which is meant to be called on the floor transition.
+     * Only the tiles of the meta-tiles the floor uses are uploaded, split across multiple frames.
+     * BG is hidden until the upload finishes.
+     */
+    void setMetaTileset(const MetaTileset&, const DungeonFloor&);
+    bool isMetaTilesetLoading() const;
 
 private:
     void _initGraphics(const bn::camera_ptr&);
 
+    /**
+     * @brief Switch the BG maps to the back buffer, and bring the new back buffer up to date.
+     */
+    void _swapCellBuffers();
+
+    /**
+     * @brief Get the palette of the dungeon BG, which has every light level if `MP_PALETTE_LIGHTING` is defined.
+     */
+    auto _getDunPaletteItem(const bn::bg_palette_item& metaTilesetPalette) -> bn::bg_palette_item;
+
+    void _setMetaTileset(const MetaTileset&, const MetaTileset::MetaTileFlags& usedMetaTiles);
+    void _uploadPendingTiles();
+
+    /**
+     * @param variant variation of the meta-tile, which is picked by masking the cell hash with `VARIANT_MASK`.
+     */
+    BN_CODE_IWRAM auto _getDunCell(const DungeonFloor::Neighbor3x3&, const DungeonFloor::NeighborDiscover3x3&,
+                                   s32 variant, s32 bgTileX, s32 bgTileY) const -> bn::regular_bg_map_cell;
+
     void _updateBgScroll(const DungeonFloor&, const mob::Monster& player);
 
     /**
-     * @brief Redraw scrolled cells on screen boundary, by 2 pass.
-     * @param scrollPhase [0..1] determine which pass this redraw is.
+     * @tparam UseVariants `false` for the single-variant lookup without the cell hash, which is only benchmarked.
      */
-    void _redrawScrolledCells(s32 scrollPhase, const DungeonFloor&, const mob::Monster& player);
+    template <bool UseVariants>
+    void _redrawAllCells(const DungeonFloor&, const mob::Monster& player);
+
+    /**
+     * @brief Redraw every cell from `topLeftCell` to `bottomRightCell`, wrapping around the BG.
+     * @tparam UseVariants `false` for the single-variant lookup without the cell hash, which is only benchmarked.
+     */
+    template <bool UseVariants>
+    BN_CODE_IWRAM void _redrawCells(const DungeonFloor&, const BoardPos& playerBoardPos, const bn::point& topLeftCell,
+                                    const bn::point& bottomRightCell);
+
+    /**
+     * @brief Redraw scrolled cells on screen boundary, which is called twice on each scroll.
+     * Each call redraws the half of the newly revealed meta-tiles, as the camera moved by a cell.
+     * Diagonal scroll redraws both the column and the row, sharing the corner cell.
+     *
+     * @param half `0` for the first half of the scroll, `1` for the second half.
+     * The cells are found from the 8 px aligned camera at the end of that half, not from the current camera,
+     * so each call redraws exactly 22 rows & 32 columns, and the redraw frames don't depend on the scroll speed.
+     * @tparam InIwram `false` for the ROM (Thumb) build of the redraw loops, which is only benchmarked.
+     */
+    template <bool InIwram>
+    void _redrawScrolledCells(const DungeonFloor&, const mob::Monster& player, s32 half);
+
+    /**
+     * @brief Redraw the column of cells from `startCell` down to `endCellY`, wrapping around the BG.
+     * @param pixelDiff pixel diff of `startCell` from the top-left of the player's meta-tile.
+     */
+    BN_CODE_IWRAM void _redrawScrolledColumn(const DungeonFloor&, const BoardPos& playerBoardPos,
+                                             const bn::point& startCell, s32 endCellY, const bn::point& pixelDiff);
+
+    /**
+     * @brief Redraw the row of cells from `startCell` right to `endCellX`, wrapping around the BG.
+     * @param pixelDiff pixel diff of `startCell` from the top-left of the player's meta-tile.
+     * @param skippedCellX column already redrawn with the scrolled column, which is `-1` if none.
+     */
+    BN_CODE_IWRAM void _redrawScrolledRow(const DungeonFloor&, const BoardPos& playerBoardPos,
+                                          const bn::point& startCell, s32 endCellX, const bn::point& pixelDiff,
+                                          s32 skippedCellX);
+
+    /**
+     * @brief Redraw a single cell, which is `pixelDiff` away from the top-left of the player's meta-tile.
+     */
+    BN_CODE_IWRAM void _redrawCell(const bn::point& cellPos, const bn::point& pixelDiff, const DungeonFloor&,
+                                   const BoardPos& playerBoardPos);
+
+#ifdef MP_DEBUG
+    // ROM (Thumb) builds of the scroll redraw above, which are kept to benchmark against.
+    void _romRedrawScrolledColumn(const DungeonFloor&, const BoardPos& playerBoardPos, const bn::point& startCell,
+                                  s32 endCellY, const bn::point& pixelDiff);
+    void _romRedrawScrolledRow(const DungeonFloor&, const BoardPos& playerBoardPos, const bn::point& startCell,
+                               s32 endCellX, const bn::point& pixelDiff, s32 skippedCellX);
+    void _romRedrawCell(const bn::point& cellPos, const bn::point& pixelDiff, const DungeonFloor&,
+                        const BoardPos& playerBoardPos);
+#endif
 
     const bn::camera_ptr& _getCamera() const;
 };
@@ -10,6 +10,7 @@
 
 #include "bn_array.h"
 #include "bn_bitset.h"
+#include "bn_common.h"
 
 #include "constants.hpp"
 #include "utils.hpp"
@@ -18,6 +19,10 @@ namespace iso_bn
 {
 class random;
 }
+namespace mp
+{
+class Arena;
+}
 
 namespace mp::game
 {
@@ -66,23 +71,25 @@ public:
 
     Type getFloorTypeOf(s32 x, s32 y) const;
     Type getFloorTypeOf(const BoardPos& pos) const;
-    auto getNeighborsOf(s32 x, s32 y) const -> Neighbor3x3;
+    BN_CODE_IWRAM auto getNeighborsOf(s32 x, s32 y) const -> Neighbor3x3;
     auto getNeighborsOf(const BoardPos& pos) const -> Neighbor3x3;
 
     s8 getBrightnessOf(s32 x, s32 y) const;
     s8 getBrightnessOf(const BoardPos& pos) const;
-    auto getNeighborBrightnessOf(s32 x, s32 y) const -> NeighborBrightness3x3;
+    BN_CODE_IWRAM auto getNeighborBrightnessOf(s32 x, s32 y) const -> NeighborBrightness3x3;
     auto getNeighborBrightnessOf(const BoardPos& pos) const -> NeighborBrightness3x3;
 
     bool getDiscoverOf(s32 x, s32 y) const;
     bool getDiscoverOf(const BoardPos& pos) const;
-    auto getNeighborDiscoverOf(s32 x, s32 y) const -> NeighborDiscover3x3;
+    BN_CODE_IWRAM auto getNeighborDiscoverOf(s32 x, s32 y) const -> NeighborDiscover3x3;
     auto getNeighborDiscoverOf(const BoardPos& pos) const -> NeighborDiscover3x3;
 
     /**
      * @brief Generate random dungeon floor.
+     *
+     * @param scratch arena that temporarily holds the generator, which is released after the generation.
      */
-    void generate(iso_bn::random& rng);
+    void generate(iso_bn::random& rng, Arena& scratch);
 
     /**
      * @brief Generate random dungeon floor with custom seeds.
@@ -91,13 +98,20 @@ public:
      * @param seed_x `iso_bn::random` internal seed x.
      * @param seed_y `iso_bn::random` internal seed y.
      * @param seed_z `iso_bn::random` internal seed z.
+     * @param scratch arena that temporarily holds the generator, which is released after the generation.
      */
-    void generate(u32 seed_x, u32 seed_y, u32 seed_z);
+    void generate(u32 seed_x, u32 seed_y, u32 seed_z, Arena& scratch);
 
     auto getSeeds() const
     {
         return _seeds;
     }
+
+    /**
+     * @brief Cheap deterministic hash of the board position, which stays the same for the same floor seeds.
+     * This is used for picking the wall/floor variations without storing them.
+     */
+    BN_CODE_IWRAM u32 getCellHash(s32 x, s32 y) const;
 };
 
 } // namespace mp::game
@@ -11,6 +11,7 @@
 #include "bn_algorithm.h"
 #include "bn_array.h"
 #include "bn_bitset.h"
+#include "bn_common.h"
 #include "bn_fixed.h"
 #include "bn_vector.h"
 
@@ -83,6 +84,18 @@ public:
      */
     void generate(Board& board, iso_bn::random& rng);
 
+#ifdef MP_DEBUG
+    /**
+     * @brief Profile the IWRAM kernels of the generation separately.
+     * (`dungeon_gen` ticket can't be nested with them.)
+     */
+    static void benchmarkKernels(iso_bn::random& rng);
+#endif
+
+private:
+    static constexpr BoardPos UDLR[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    static constexpr BoardPos DIAGONAL[4] = {{-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
 private:
     bn::vector<BoardPos, ROWS * COLUMNS / 2 + 4> _wallsNearFloor;
     bn::bitset<ROWS * COLUMNS> _wallsNearFloorAdded;
@@ -113,6 +126,26 @@ private:
     bool _placeRoom(Room& room, Board& board, iso_bn::random& rng);
 
     Room _createCellularRoom(iso_bn::random& rng) const;
+
+    /**
+     * @brief Single round of cellular automata smoothing from `prev` to `cur`.
+     * Adjacent floor < 4 becomes a wall, adjacent floor >= 6 becomes a floor.
+     */
+    BN_CODE_IWRAM static void _smoothCellularRoom(const Room& prev, Room& cur);
+
+    /**
+     * @brief BFS used in Cellular automata room generation.
+     * @param removeMode if enabled, fill in the passed small blob with walls.
+     * @return size of the blob.
+     */
+    BN_CODE_IWRAM static s32 _bfsCellular(s8 x, s8 y, bool removeMode, Room& room, Room& visited);
+
+    /**
+     * @brief Find the biggest connected blob, and remove the other small blobs.
+     * @return `false` if resulting room is smaller than `CELLULAR_ROOM_MIN_CELLS_COUNT`.
+     */
+    static bool _removeSmallBlobs(Room& room, Room& visited);
+
     Room _createSquareRoom(iso_bn::random& rng) const;
     Room _createCrossRoom(iso_bn::random& rng) const;
 
@@ -11,6 +11,7 @@
 #include "bn_sprite_ptr.h"
 #include "bn_vector.h"
 
+#include "DigitText.hpp"
 #include "Settings.hpp"
 #include "typedefs.hpp"
 
@@ -64,9 +65,9 @@ private:
     s32 _maxBelly;
     s32 _bellyGaugeGraphicsIndex;
 
-    bn::vector<bn::sprite_ptr, 1> _currentBellySprite;
+    DigitText _currentBellyText;
     bn::vector<bn::sprite_ptr, 2> _bellyMiscSprites;
-    bn::vector<bn::sprite_ptr, 1> _maxBellySprite;
+    DigitText _maxBellyText;
     bn::sprite_ptr _bellyGaugeSprite;
 
     bn::sprite_ptr _inventorySquareSprite;
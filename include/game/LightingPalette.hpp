@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+#include "bn_color.h"
+#include "bn_regular_bg_map_cell_info.h"
+
+#include "game/DungeonFloor.hpp"
+#include "typedefs.hpp"
+
+namespace bn
+{
+class bg_palette_item;
+}
+
+namespace mp::game
+{
+
+/**
+ * @brief Palette based lighting, which replaces the shadow BG layer if `MP_PALETTE_LIGHTING` is defined.
+ * Dungeon palette is repeated on every palette bank with darker colors, and each cell picks its bank by brightness.
+ */
+class LightingPalette
+{
+public:
+    static constexpr s32 LIGHT_LEVELS = 2;
+    static constexpr s32 BANK_COLORS_COUNT = 16;
+    static constexpr s32 COLORS_COUNT = BANK_COLORS_COUNT * LIGHT_LEVELS;
+
+    static_assert(LIGHT_LEVELS >= 2);
+
+    using Colors = bn::array<bn::color, COLORS_COUNT>;
+
+public:
+    LightingPalette() = delete;
+
+    /**
+     * @brief Build palette banks of every light level from the 4bpp dungeon palette.
+     * Bank 0 is the fully lit original, and the last one is the darkest.
+     */
+    static void buildColors(const bn::bg_palette_item& srcPalette, Colors& destColors);
+
+    /**
+     * @brief Bake the light level into the palette bank of the dungeon cell.
+     *
+     * @param neighbors neighbors' brightness (center is self)
+     */
+    static auto getLitCell(bn::regular_bg_map_cell cell, const DungeonFloor::NeighborBrightness3x3& neighbors)
+        -> bn::regular_bg_map_cell
+    {
+        bn::regular_bg_map_cell_info cellInfo(cell);
+        cellInfo.set_palette_id(_calcLightLevel(neighbors));
+        return cellInfo.cell();
+    }
+
+private:
+    /**
+     * @brief Same light rule with `ShadowTileset`, so that both lighting backends look alike.
+     */
+    static s32 _calcLightLevel(const DungeonFloor::NeighborBrightness3x3& neighbors)
+    {
+        if (neighbors[1][1] > 0)
+            return 0; // light
+
+        return LIGHT_LEVELS - 1; // shadow
+    }
+};
+
+} // namespace mp::game
@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "typedefs.hpp"
+
+namespace mp::game
+{
+
+/**
+ * @brief Message log text kind.
+ * DO NOT change order, as indices are used for querying `texts::LOG_TEXTS`.
+ */
+enum LogTextKind : u8
+{
+    ITEM_PICKED_UP = 0,
+    ITEM_USED,
+    ITEM_TOSSED,
+
+    // total log texts count
+    TOTAL_LOG_TEXTS
+};
+
+} // namespace mp::game
@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_algorithm.h"
+#include "bn_array.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_map_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_span.h"
+
+#include "Settings.hpp"
+#include "game/LogTextKind.hpp"
+#include "typedefs.hpp"
+
+#include "texts_glyphs.h"
+
+namespace bn
+{
+class sprite_font;
+}
+namespace mp
+{
+class TextGen;
+}
+
+namespace mp::game
+{
+
+class MessageLog;
+
+class MessageLogObserveSettings final : public SettingsObserver
+{
+public:
+    MessageLogObserveSettings(MessageLog&, Settings&);
+
+    void onLangChange([[maybe_unused]] Settings::Language prevLang, Settings::Language newLang) override;
+
+private:
+    MessageLog& _log;
+};
+
+/**
+ * @brief Argument that replaces `{}` in the log text.
+ * It's stored as is, and converted to text only when drawn, so that it follows the language change.
+ */
+struct LogArg
+{
+    enum class Type : u8
+    {
+        NONE,
+        NUMBER,
+        ITEM_NAME,
+    };
+
+    Type type = Type::NONE;
+    s16 value = 0;
+
+    static constexpr LogArg number(s16 num)
+    {
+        return LogArg{Type::NUMBER, num};
+    }
+
+    static constexpr LogArg itemName(u8 itemKind)
+    {
+        return LogArg{Type::ITEM_NAME, itemKind};
+    }
+};
+
+/**
+ * @brief Scrolling event log, drawn into a text BG layer.
+ * Messages are kept in a fixed ring buffer, and only the newly added line is drawn.
+ * Texts are drawn from the build-time generated glyph ids, so no UTF-8 decoding happens at runtime.
+ */
+class MessageLog final
+{
+public:
+    static constexpr s32 CAPACITY = 8;
+    static constexpr s32 VISIBLE_LINES = 3;
+    static constexpr s32 LINE_MAX_CHARS = 30;
+
+    static constexpr s32 ROWS = 256 / 8;
+    static constexpr s32 COLUMNS = 256 / 8;
+    static constexpr s32 CELLS_COUNT = ROWS * COLUMNS;
+
+    /**
+     * @brief Max number of different glyphs uploaded to VRAM at once, which is the VRAM tiles budget of the log.
+     * Fewer slots are allocated if a language has fewer glyphs than this.
+     */
+    static constexpr s32 GLYPH_SLOTS_COUNT = 128;
+
+    /**
+     * @brief Different glyphs needed to draw the visible lines, when every char of them is a different glyph.
+     * Space is not counted, as its cell is left blank.
+     */
+    static constexpr s32 SCREEN_GLYPHS_MAX_COUNT =
+        bn::min(VISIBLE_LINES * LINE_MAX_CHARS, texts::glyphs::MAX_GLYPHS - 1);
+
+    static_assert(VISIBLE_LINES <= CAPACITY);
+    static_assert(SCREEN_GLYPHS_MAX_COUNT <= GLYPH_SLOTS_COUNT, "Visible lines might not fit in the glyph slots");
+
+    struct Entry
+    {
+        LogTextKind kind;
+        LogArg arg;
+    };
+
+public:
+    MessageLog(TextGen&, Settings&);
+
+    void update();
+
+    void add(LogTextKind, const LogArg& = {});
+    void clear();
+
+    bool isVisible() const;
+    void setVisible(bool isVisible);
+
+private:
+    void _initGraphics();
+
+    /**
+     * @brief Resolve glyph ids of every language to the font graphics indexes, which is done only once.
+     */
+    void _resolveGlyphs();
+
+    /**
+     * @brief Get the entry by its order, from the oldest one.
+     */
+    auto _getEntry(s32 order) const -> const Entry&;
+
+    /**
+     * @brief Which BG line the entry with `order` is drawn to.
+     */
+    s32 _getBgLine(s32 order) const;
+
+    void _redrawVisibleLines();
+
+    /**
+     * @return `false` if glyph slots became full while drawing.
+     */
+    bool _drawLine(s32 bgLine, const Entry&);
+    void _clearLine(s32 bgLine);
+    void _updateBgPos();
+
+    /**
+     * @brief Draw the glyphs from the `column` of the `bgLine`, replacing `PLACEHOLDER_ID` with `arg`.
+     * @return column next to the last drawn glyph, or `-1` if glyph slots became full.
+     */
+    s32 _drawGlyphs(s32 bgLine, s32 column, bn::span<const u8> glyphIds, const LogArg& arg);
+    s32 _drawArg(s32 bgLine, s32 column, const LogArg& arg);
+    s32 _drawGlyph(s32 bgLine, s32 column, u8 glyphId);
+
+    /**
+     * @brief Find the glyph slot of the glyph id of the current language.
+     * Its tiles are uploaded if it's not uploaded yet.
+     * @return `-1` if glyph slots are full.
+     */
+    s32 _findOrUploadGlyph(u8 glyphId);
+    void _clearGlyphSlots();
+
+    s32 _getGraphicsIndex(const bn::string_view& utf8Char) const;
+
+private:
+    const bn::sprite_font& _font;
+    const Settings& _settings;
+    const s32 _glyphRows;
+
+    bn::array<Entry, CAPACITY> _entries;
+    s32 _entriesHead = 0;
+    s32 _entriesCount = 0;
+    // total number of added entries, which decides the BG line of each entry.
+    s32 _addedCount = 0;
+
+    // [lang][glyph id] -> font graphics index
+    bn::array<bn::array<u16, texts::glyphs::MAX_GLYPHS>, Settings::TOTAL_LANGUAGES> _glyphGraphicsIndexes;
+    // glyph id of the current language -> glyph slot (`-1` if not uploaded)
+    bn::array<s16, texts::glyphs::MAX_GLYPHS> _glyphSlots;
+    s32 _usedGlyphSlotsCount = 0;
+
+    alignas(4) bn::regular_bg_map_cell _cells[CELLS_COUNT];
+    bn::regular_bg_map_item _mapItem;
+    bn::regular_bg_tiles_ptr _tiles;
+    bn::bg_palette_ptr _palette;
+    bn::regular_bg_ptr _bg;
+    bn::regular_bg_map_ptr _bgMap;
+
+    bool _cellsReloadRequired = false;
+
+private:
+    friend class MessageLogObserveSettings;
+    MessageLogObserveSettings _settingsObserver;
+};
+
+} // namespace mp::game
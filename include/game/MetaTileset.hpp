@@ -10,6 +10,8 @@
 
 #include "bn_array.h"
 #include "bn_assert.h"
+#include "bn_bitset.h"
+#include "bn_common.h"
 #include "bn_regular_bg_item.h"
 #include "bn_regular_bg_map_cell.h"
 #include "bn_regular_bg_map_item.h"
@@ -75,18 +77,57 @@ public:
     using TileIndex = MetaTile::TileIndex;
     static constexpr TileIndex TILES_COUNT = MetaTile::TILES_COUNT;
 
+    // which meta-tiles are used
+    using MetaTileFlags = bn::bitset<TILES_COUNT>;
+
+    /**
+     * @brief Number of variations per meta-tile, picked by the cell hash.
+     * Must be the power of 2, as the variation is picked by masking the hash.
+     */
+    static constexpr s32 VARIANTS_COUNT = 4;
+    static_assert((VARIANTS_COUNT & (VARIANTS_COUNT - 1)) == 0);
+
+    /**
+     * @brief Flattened `[metaTileIdx * VARIANTS_COUNT + variant]` table of the variation meta-tile indexes.
+     */
+    using VariantTable = bn::array<TileIndex, TILES_COUNT * VARIANTS_COUNT>;
+
+    /**
+     * @brief Every variation is the meta-tile itself, for the tilesets without variations.
+     */
+    static constexpr VariantTable NO_VARIANTS = [] {
+        VariantTable result{};
+        for (s32 i = 0; i < TILES_COUNT * VARIANTS_COUNT; ++i)
+            result[i] = (TileIndex)(i / VARIANTS_COUNT);
+        return result;
+    }();
+
 public:
     static auto fromKind(MetaTilesetKind) -> const MetaTileset&;
 
+    /**
+     * @brief Calculate meta-tile index by looking at the floor's neighbors.
+     *
+     * @param neighbors neighbor floors (center is self)
+     * @param discovers neighbors' discover status (center is self)
+     * @return TileIndex
+     */
+    BN_CODE_IWRAM static TileIndex calcMetaTileIndex(const DungeonFloor::Neighbor3x3& neighbors,
+                                                     const DungeonFloor::NeighborDiscover3x3& discovers);
+
 public:
     constexpr MetaTileset() = delete;
 
-    constexpr MetaTileset(const bn::regular_bg_item& bgItem) : _bgItem(bgItem)
+    constexpr MetaTileset(const bn::regular_bg_item& bgItem, const VariantTable& variants = NO_VARIANTS)
+        : _bgItem(bgItem), _variants(variants)
     {
         const auto& mapItem = bgItem.map_item();
 
         for (s32 i = 0; i < TILES_COUNT; ++i)
             _metaTiles[i] = MetaTile(mapItem, i);
+
+        for (s32 i = 0; i < TILES_COUNT * VARIANTS_COUNT; ++i)
+            BN_ASSERT(variants[i] < TILES_COUNT, "Invalid variant meta-tile idx(", variants[i], ")");
     }
 
     constexpr auto getBgItem() const -> const bn::regular_bg_item&
@@ -94,6 +135,33 @@ public:
         return _bgItem;
     }
 
+    constexpr auto getMetaTile(TileIndex idx) const -> const MetaTile&
+    {
+        BN_ASSERT(idx < TILES_COUNT, "Invalid meta-tile idx(", idx, ")");
+
+        return _metaTiles[idx];
+    }
+
+    /**
+     * @brief Get the meta-tile index of the variation.
+     *
+     * @param idx meta-tile index calculated by the neighbors
+     * @param variant variation [0..VARIANTS_COUNT)
+     */
+    constexpr auto getVariant(TileIndex idx, s32 variant) const -> TileIndex
+    {
+        BN_ASSERT(idx < TILES_COUNT, "Invalid meta-tile idx(", idx, ")");
+        BN_ASSERT(0 <= variant && variant < VARIANTS_COUNT, "Invalid variant(", variant, ")");
+
+        return _variants[idx * VARIANTS_COUNT + variant];
+    }
+
+    /**
+     * @brief Find every meta-tile needed to draw the floor (including their variations) and the area outside of it.
+     * Both discovered and undiscovered status are taken into account.
+     */
+    auto calcUsedMetaTiles(const DungeonFloor&) const -> MetaTileFlags;
+
     /**
      * @brief Get cell by neighbor floors, their discover status & 2x2 bg tile coordinate.
      *
@@ -106,20 +174,10 @@ public:
     auto getCell(const DungeonFloor::Neighbor3x3& neighbors, const DungeonFloor::NeighborDiscover3x3& discovers,
                  s32 bgTileX, s32 bgTileY) const -> bn::regular_bg_map_cell;
 
-private:
-    /**
-     * @brief Calculate meta-tile index by looking at the floor's neighbors.
-     *
-     * @param neighbors neighbor floors (center is self)
-     * @param discovers neighbors' discover status (center is self)
-     * @return TileIndex
-     */
-    static TileIndex _calcMetaTileIndex(const DungeonFloor::Neighbor3x3& neighbors,
-                                        const DungeonFloor::NeighborDiscover3x3& discovers);
-
 private:
     const bn::regular_bg_item& _bgItem;
     bn::array<MetaTile, TILES_COUNT> _metaTiles;
+    VariantTable _variants;
 };
 
 } // namespace mp::game
@@ -12,12 +12,21 @@
 #include "bn_affine_bg_map_item.h"
 #include "bn_affine_bg_map_ptr.h"
 #include "bn_affine_bg_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_point.h"
 #include "bn_sprite_actions.h"
 #include "bn_sprite_ptr.h"
+#include "bn_vector.h"
 
 #include "constants.hpp"
+#include "game/BoardPos.hpp"
 #include "typedefs.hpp"
 
+namespace mp
+{
+class Arena;
+}
+
 namespace mp::game
 {
 
@@ -28,6 +37,15 @@ class Monster;
 
 class DungeonFloor;
 
+/**
+ * @brief Full-screen map view of the dungeon floor, drawn with an affine BG.
+ * Zoom level is changed only with the affine parameters, so the cells are never rebuilt by it.
+ *
+ * Entities are stamped on the terrain cells as an overlay, and the terrain is restored when they leave.
+ * Only the cells of the stamped entities are redrawn, so the per-turn cost doesn't depend on the floor size.
+ *
+ * Stamped items & enemies are also marked with pooled sprites, which stay readable when the cells are zoomed out.
+ */
 class MiniMap final
 {
 private:
@@ -38,8 +56,65 @@ public:
     static constexpr s32 COLUMNS = consts::DUNGEON_FLOOR_SIZE.width();
     static constexpr s32 CELLS_COUNT = consts::DUNGEON_FLOOR_CELLS_COUNT;
 
+    static constexpr s32 STAMPS_MAX_COUNT = consts::DUNGEON_MOB_MAX_COUNT + consts::DUNGEON_ITEM_MAX_COUNT;
+
+    /**
+     * @brief Max number of item & enemy markers shown at once, which are pooled sprites.
+     */
+    static constexpr s32 MARKERS_MAX_COUNT = 16;
+
+    /**
+     * @brief Number of rows redrawn per frame, after `redrawAll()` is called.
+     */
+    static constexpr s32 REDRAW_ROWS_PER_FRAME = 8;
+
+    enum class Zoom : u8
+    {
+        X1,
+        X1_2,
+        X1_4,
+
+        TOTAL_ZOOMS
+    };
+
+    /**
+     * @brief Entity kinds stamped on the map, from the lowest draw priority to the highest.
+     */
+    enum class StampKind : u8
+    {
+        ELEVATOR,
+        TRAP,
+        ITEM,
+        NPC,
+        ENEMY,
+        BOSS,
+
+        TOTAL_STAMP_KINDS
+    };
+
+private:
+    struct Stamp
+    {
+        BoardPos boardPos;
+        StampKind kind;
+    };
+
+    struct Cells
+    {
+        alignas(4) bn::affine_bg_map_cell cells[CELLS_COUNT];
+    };
+
+    // bit of each `StampKind` stamped on a cell.
+    struct StampMasks
+    {
+        u8 masks[CELLS_COUNT];
+    };
+
+    static_assert((s32)StampKind::TOTAL_STAMP_KINDS <= 8, "Stamp kinds don't fit in a byte");
+
 private:
-    alignas(4) bn::affine_bg_map_cell _cells[CELLS_COUNT];
+    // handed out by the scene arena.
+    bn::affine_bg_map_cell* const _cells;
     bn::affine_bg_map_item _mapItem;
     bn::affine_bg_item _bgItem;
     bn::affine_bg_ptr _bg;
@@ -48,24 +123,100 @@ private:
     bn::sprite_ptr _playerCursor;
     bn::sprite_visible_toggle_action _playerCursorFlickerAction;
 
+    bn::vector<bn::sprite_ptr, MARKERS_MAX_COUNT> _markers;
+    bn::vector<BoardPos, MARKERS_MAX_COUNT> _markerBoardPositions;
+
+    bn::vector<Stamp, STAMPS_MAX_COUNT> _stamps;
+    // handed out by the scene arena, indexed by the cell index.
+    u8* const _stampMasks;
+
+    BoardPos _playerBoardPos;
+    Zoom _zoom = Zoom::X1_2;
+
+    // floor being redrawn by rows, which is `nullptr` if every row is redrawn.
+    const DungeonFloor* _redrawFloor = nullptr;
+    s32 _redrawRow = 0;
+
+    // cells changed after the last reload, which are kept in RAM while the map is hidden.
     bool _cellsReloadRequired = false;
 
 public:
-    MiniMap();
+    /**
+     * @param arena scene arena, which hands out the cells & the stamp masks.
+     */
+    explicit MiniMap(Arena& arena);
 
     void update();
     void updateBgPos(const mob::Monster& player);
 
+    /**
+     * @brief Stamp an entity on the board pos, drawn over the terrain.
+     */
+    void addStamp(StampKind, const BoardPos&, const DungeonFloor&);
+
+    /**
+     * @brief Remove a stamp of the kind on the board pos, and restore the cell.
+     */
+    void removeStamp(StampKind, const BoardPos&, const DungeonFloor&);
+
+    /**
+     * @brief Move a stamp of the kind, which only redraws the previous & the new cell.
+     */
+    void moveStamp(StampKind, const BoardPos& from, const BoardPos& to, const DungeonFloor&);
+
+    /**
+     * @brief Remove every stamp without redrawing, which is meant to be followed by `redrawAll()`.
+     */
+    void clearStamps();
+
+    /**
+     * @brief Redraw every cell, split across multiple frames.
+     * The floor should stay alive until it's done.
+     */
     void redrawAll(const DungeonFloor&);
     void redrawCell(s32 x, s32 y, const DungeonFloor&);
 
     bool isVisible() const;
     void setVisible(bool isVisible);
 
+    auto getZoom() const -> Zoom;
+    void setZoom(Zoom);
+    void zoomIn();
+    void zoomOut();
+
 private:
     void _initGraphics();
 
+    void _redrawPendingRows();
+    void _reloadCells();
+
+    /**
+     * @brief Assign the markers to the stamped items & enemies.
+     * Markers over `MARKERS_MAX_COUNT` are not shown.
+     */
+    void _updateMarkers();
+
+    /**
+     * @brief Place the BG, the player cursor and the markers, with the current zoom level.
+     * Player is focused on, except for the smallest zoom level which shows the whole floor.
+     */
+    void _updatePositions();
+
+    /**
+     * @brief Get the focused pixel of the unscaled map, from the center of the BG.
+     */
+    auto _getFocus() const -> bn::point;
+    auto _getScreenPos(const BoardPos&) const -> bn::fixed_point;
+
     TileIndex _calculateTileIndex(s32 x, s32 y, const DungeonFloor&) const;
+
+    /**
+     * @brief Find the highest priority stamp on the board pos, from its stamp mask.
+     * @return `TOTAL_STAMP_KINDS` if nothing is stamped.
+     */
+    StampKind _findTopStampKind(s32 x, s32 y) const;
+
+    bool _hasStamp(StampKind, const BoardPos&) const;
 };
 
 } // namespace mp::game
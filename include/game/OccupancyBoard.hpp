@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+
+#include "constants.hpp"
+#include "game/BoardPos.hpp"
+#include "typedefs.hpp"
+
+namespace mp::game
+{
+
+/**
+ * @brief 1 bit per dungeon floor cell, which marks if something occupies it.
+ * Lets the hit checks skip scanning the monster & item lists.
+ */
+class OccupancyBoard final
+{
+public:
+    static constexpr s32 ROWS = consts::DUNGEON_FLOOR_SIZE.height();
+    static constexpr s32 COLUMNS = consts::DUNGEON_FLOOR_SIZE.width();
+    static constexpr s32 WORDS_PER_ROW = COLUMNS / 32;
+
+    static_assert(COLUMNS % 32 == 0);
+
+public:
+    OccupancyBoard();
+
+    bool has(const BoardPos&) const;
+
+    void set(const BoardPos&);
+    void reset(const BoardPos&);
+    void move(const BoardPos& from, const BoardPos& to);
+
+    void clear();
+
+private:
+    bn::array<u32, ROWS * WORDS_PER_ROW> _words;
+};
+
+} // namespace mp::game
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+
+#include "game/mob/MonsterSpeed.hpp"
+#include "game/mob/MonsterTable.hpp"
+#include "typedefs.hpp"
+
+namespace mp::game
+{
+
+/**
+ * @brief Decides who acts next, with a timing wheel of ticks.
+ *
+ * Acting actor is scheduled again after a delay of ticks, which is shorter for faster actors.
+ * Each wheel bucket is a FIFO list of actors, so actors scheduled on the same tick act in the scheduled order.
+ * It makes the order fully deterministic, with no sorting on any turn.
+ *
+ * Actor ids are the `MonsterTable` handle slots, and `PLAYER_ACTOR` for the player.
+ */
+class TurnScheduler final
+{
+public:
+    static constexpr s32 ACTORS_COUNT = mob::MonsterTable::MAX_COUNT + 1;
+    static constexpr u8 PLAYER_ACTOR = mob::MonsterTable::MAX_COUNT;
+
+    static constexpr s32 NORMAL_DELAY = 12;
+    static constexpr bn::array<u8, (s32)mob::MonsterSpeed::TOTAL_SPEEDS> DELAYS = {
+        NORMAL_DELAY * 3, NORMAL_DELAY * 2, NORMAL_DELAY, NORMAL_DELAY / 2, NORMAL_DELAY / 3,
+    };
+
+    // should be bigger than the longest delay, and a power of 2.
+    static constexpr s32 WHEEL_SIZE = 64;
+
+    static_assert(ACTORS_COUNT <= 0x7F);
+    static_assert(NORMAL_DELAY % 6 == 0, "NORMAL_DELAY should be divisible by 2 & 3");
+    static_assert(NORMAL_DELAY * 3 < WHEEL_SIZE);
+    static_assert((WHEEL_SIZE & (WHEEL_SIZE - 1)) == 0);
+
+public:
+    TurnScheduler();
+
+    /**
+     * @brief Remove every actor, and rewind the tick.
+     */
+    void clear();
+
+    /**
+     * @brief Schedule a new actor, who acts after a delay of their speed.
+     */
+    void add(u8 actor, mob::MonsterSpeed);
+
+    void remove(u8 actor);
+
+    /**
+     * @brief Schedule the actor who just acted again, after a delay of their speed.
+     */
+    void reschedule(u8 actor);
+
+    /**
+     * @brief Pop the actor who acts next, advancing the tick to their scheduled one.
+     * The popped actor is not scheduled, until `reschedule()` is called.
+     */
+    u8 popNext();
+
+    bool isScheduled(u8 actor) const;
+
+    auto getSpeed(u8 actor) const -> mob::MonsterSpeed;
+
+    /**
+     * @brief Change the speed of the actor, which applies from their next `reschedule()`.
+     */
+    void setSpeed(u8 actor, mob::MonsterSpeed);
+
+    u16 getTick() const;
+
+private:
+    void _push(u8 actor, u16 tick);
+    void _unlink(u8 actor);
+
+private:
+    static constexpr s8 NIL = -1;
+
+    u16 _tick = 0;
+
+    // FIFO list of actors for each tick bucket.
+    bn::array<s8, WHEEL_SIZE> _bucketHeads;
+    bn::array<s8, WHEEL_SIZE> _bucketTails;
+
+    bn::array<s8, ACTORS_COUNT> _nexts;
+    bn::array<s8, ACTORS_COUNT> _prevs;
+    bn::array<u16, ACTORS_COUNT> _scheduledTicks;
+    bn::array<mob::MonsterSpeed, ACTORS_COUNT> _speeds;
+    bn::array<bool, ACTORS_COUNT> _isScheduled;
+};
+
+} // namespace mp::game
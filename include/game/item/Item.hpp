@@ -11,6 +11,7 @@
 #include "bn_sprite_ptr.h"
 
 #include "game/BoardPos.hpp"
+#include "game/item/ItemRecord.hpp"
 
 namespace bn
 {
@@ -25,43 +26,30 @@ class Player;
 namespace mp::game::item
 {
 
-enum ItemKind : u8;
 class ItemInfo;
 
 /**
- * @brief Items can be picked up, used, and thrown.
+ * @brief Item on the dungeon floor, which can be picked up.
+ * Picked up items are kept in the bag as `ItemRecord`, without a sprite.
  */
 class Item final
 {
 public:
-    /**
-     * @brief Constructor for item on the dungeon floor.
-     *
-     */
-    Item(ItemKind, const BoardPos&, const mob::Player&, const bn::camera_ptr&);
-
-    /**
-     * @brief Constructor for item in the inventory.
-     *
-     */
-    Item(ItemKind, const mob::Player&);
+    Item(const ItemRecord&, const BoardPos&, const mob::Player&, const bn::camera_ptr&);
 
     Item(const Item&) = delete;
     Item(Item&&);
 
-    bool isInInventory() const;
-
-    void moveSpriteToDungeonFloor(const BoardPos& boardPos, const bn::camera_ptr& camera);
-    void moveSpriteToInventory();
-
     auto getBoardPos() const -> const BoardPos&;
     void setBoardPos(const BoardPos&);
 
     auto getItemInfo() const -> const ItemInfo&;
+    auto getRecord() const -> ItemRecord;
+
+    auto getSprite() const -> const bn::sprite_ptr&;
 
 private:
-    void _initGraphicsForInventoryItem();
-    void _initGraphicsForDungeonFloorItem(const bn::camera_ptr&);
+    void _initGraphics(const bn::camera_ptr&);
     void _updateSpritePos();
 
 private:
@@ -70,6 +58,7 @@ private:
 
     bn::sprite_ptr _sprite;
     BoardPos _pos;
+    u8 _flags;
 };
 
 } // namespace mp::game::item
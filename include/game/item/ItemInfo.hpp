@@ -19,10 +19,6 @@ namespace bn
 {
 class sprite_item;
 }
-namespace mp::game::item::ability
-{
-class ItemAbility;
-}
 
 namespace mp::game::item
 {
@@ -40,16 +36,14 @@ public:
     const s32 tossDistance;
     const bn::sprite_item& spriteItem;
     const s32 graphicsIndex;
-    const ability::ItemAbility& ability;
     const texts::LangTexts& name;
     const texts::LangTexts& description;
 
 public:
     constexpr ItemInfo(ItemKind kind_, bool canBeUsed_, s32 tossDistance_, const bn::sprite_item& spriteItem_,
-                       s32 graphicsIndex_, const ability::ItemAbility& ability_, const texts::LangTexts& name_,
-                       const texts::LangTexts& description_)
+                       s32 graphicsIndex_, const texts::LangTexts& name_, const texts::LangTexts& description_)
         : kind(kind_), canBeUsed(canBeUsed_), tossDistance(tossDistance_), spriteItem(spriteItem_),
-          graphicsIndex(graphicsIndex_), ability(ability_), name(name_), description(description_)
+          graphicsIndex(graphicsIndex_), name(name_), description(description_)
     {
         BN_ASSERT(tossDistance <= 4, "tossDistance(", tossDistance, ") should be less than 5 to be seen on screen");
     }
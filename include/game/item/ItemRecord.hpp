@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "game/item/ItemKind.hpp"
+#include "typedefs.hpp"
+
+namespace mp::game::item
+{
+
+/**
+ * @brief Compact item state without any graphics, which is what the bag keeps.
+ * A sprite is only created when it's shown, either on the dungeon floor or in the HUD.
+ */
+struct ItemRecord
+{
+    ItemKind kind;
+    // per-item state bits, which follow the item through pickup & toss.
+    u8 flags = 0;
+};
+
+static_assert(sizeof(ItemRecord) == 2);
+
+} // namespace mp::game::item
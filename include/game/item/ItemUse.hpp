@@ -9,8 +9,13 @@
 #pragma once
 
 #include "bn_optional.h"
+#include "bn_sprite_actions.h"
+#include "bn_sprite_ptr.h"
+#include "bn_vector.h"
 
+#include "constants.hpp"
 #include "game/item/Item.hpp"
+#include "game/item/ItemRecord.hpp"
 
 namespace mp::game
 {
@@ -26,25 +31,68 @@ namespace mp::game::item
  * 2. use/toss animation
  * 3. choosing where to toss
  * 4. item ability applied to monsters
+ *
+ * The bag only keeps `ItemRecord`s, and the only item sprite it owns is the selected one shown in the HUD.
  */
 class ItemUse final
 {
+public:
+    static constexpr s32 BAG_CAPACITY = consts::MOB_ITEM_MAX_COUNT;
+
 public:
     ItemUse(Hud&);
 
+    void update();
+
     bool isOngoing() const;
 
-    bool hasInventoryItem() const;
-    auto getInventoryItem() -> bn::optional<Item>&;
-    auto getInventoryItem() const -> const bn::optional<Item>&;
-    void setInventoryItem(Item&& item);
+    bool hasSelectedItem() const;
+    bool isBagFull() const;
+    s32 getBagCount() const;
+
+    auto getSelectedItem() const -> const ItemRecord&;
+    auto getSelectedItemInfo() const -> const ItemInfo&;
+
+    /**
+     * @brief Put the item into the bag, which is selected if nothing was selected.
+     */
+    void addItem(const ItemRecord&);
+
+    /**
+     * @brief Select the next item in the bag, wrapping around to the first one.
+     */
+    void selectNextItem();
+
+    /**
+     * @brief Replace the selected item in place. (e.g. banana -> banana peel)
+     */
+    void replaceSelectedItem(const ItemRecord&);
+
+    /**
+     * @brief Take the selected item out of the bag, and select the next one.
+     */
+    auto releaseSelectedItem() -> ItemRecord;
+
+    /**
+     * @brief Animate the tossed item from the player to where it landed, which is its current sprite position.
+     * @param tiles number of tiles it flew.
+     */
+    void startTossAnimation(const Item& tossed, const bn::camera_ptr&, s32 tiles);
+
+private:
+    /**
+     * @brief Update the HUD & the selected item sprite, which is only created while the bag has an item.
+     */
+    void _refreshSelectedItem();
 
 private:
     Hud& _hud;
 
-    bn::optional<Item> _inventoryItem;
+    bn::vector<ItemRecord, BAG_CAPACITY> _bag;
+    s32 _selectedIdx = 0;
+    bn::optional<bn::sprite_ptr> _selectedSprite;
 
-    // TODO: Add item animations
+    bn::optional<bn::sprite_move_to_action> _tossAction;
 };
 
 } // namespace mp::game::item
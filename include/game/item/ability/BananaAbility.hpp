@@ -13,17 +13,6 @@
 namespace mp::game::item::ability
 {
 
-class BananaAbility final : public ItemAbility
-{
-public:
-    constexpr ~BananaAbility(){};
-
-    ItemKind getItemKind() const override
-    {
-        return ItemKind::BANANA;
-    }
-
-    void use(mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&) const override;
-};
+void useBanana(mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&);
 
 } // namespace mp::game::item::ability
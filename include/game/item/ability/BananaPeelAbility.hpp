@@ -13,17 +13,6 @@
 namespace mp::game::item::ability
 {
 
-class BananaPeelAbility final : public ItemAbility
-{
-public:
-    constexpr ~BananaPeelAbility(){};
-
-    ItemKind getItemKind() const override
-    {
-        return ItemKind::BANANA_PEEL;
-    }
-
-    void stepOn(mob::Monster& mob, ItemUse&, Dungeon&, iso_bn::random&) const override;
-};
+void stepOnBananaPeel(mob::MonsterTable& monsters, s32 monsterIndex, ItemUse&, Dungeon&, iso_bn::random&);
 
 } // namespace mp::game::item::ability
@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include "bn_common.h"
+#include "bn_span.h"
+
 #include "game/item/ItemKind.hpp"
+#include "typedefs.hpp"
 
 namespace iso_bn
 {
@@ -24,30 +28,66 @@ class ItemUse;
 }
 namespace mp::game::mob
 {
-class Monster;
+class MonsterTable;
 class Player;
 } // namespace mp::game::mob
 
 namespace mp::game::item::ability
 {
 
-class ItemAbility
-{
-public:
-    constexpr virtual ~ItemAbility(){};
+/**
+ * @brief This command fires when the player uses the item.
+ * (e.g. Consume food, read scroll, etc.)
+ */
+using UseFn = void (*)(mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&);
 
-    virtual ItemKind getItemKind() const = 0;
+/**
+ * @brief This command fires when the monster steps on the item, or the item is tossed at the monster.
+ * @param monsterIndex dense index of the monster in `monsters`.
+ */
+using StepOnFn = void (*)(mob::MonsterTable& monsters, s32 monsterIndex, ItemUse&, Dungeon&, iso_bn::random&);
 
-    /**
-     * @brief This command fires when the player uses the item.
-     * (e.g. Consume food, read scroll, etc.)
-     */
-    virtual void use(mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&) const;
+/**
+ * @brief Ability of an item kind, which is an entry of the constexpr dispatch table indexed by `ItemKind`.
+ */
+struct ItemAbility
+{
+    ItemKind kind;
+    UseFn use;
+    StepOnFn stepOn;
+};
 
-    /**
-     * @brief This command fires when the monster steps on the item.
-     */
-    virtual void stepOn(mob::Monster& mob, ItemUse&, Dungeon&, iso_bn::random&) const;
+/**
+ * @brief Monster which stepped on an item, for `stepOnAll()`.
+ */
+struct StepOnHit
+{
+    ItemKind itemKind;
+    s8 monsterIndex;
 };
 
+auto fromKind(ItemKind) -> const ItemAbility&;
+
+// Dispatches below run from IWRAM as ARM code, as they're called for every item use & every monster step.
+
+BN_CODE_IWRAM void use(ItemKind, mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&);
+BN_CODE_IWRAM void stepOn(ItemKind, mob::MonsterTable& monsters, s32 monsterIndex, ItemUse&, Dungeon&,
+                          iso_bn::random&);
+
+/**
+ * @brief Apply `stepOn` of every hit in one pass, which are collected from the monsters moved in a turn.
+ */
+BN_CODE_IWRAM void stepOnAll(bn::span<const StepOnHit> hits, mob::MonsterTable& monsters, ItemUse&, Dungeon&,
+                             iso_bn::random&);
+
+/**
+ * @brief Default `UseFn`, for the items which can't be used.
+ */
+void useNothing(mob::Player& user, ItemUse&, Dungeon&, iso_bn::random&);
+
+/**
+ * @brief Default `StepOnFn`, where nothing happens.
+ */
+void stepOnNothing(mob::MonsterTable& monsters, s32 monsterIndex, ItemUse&, Dungeon&, iso_bn::random&);
+
 } // namespace mp::game::item::ability
@@ -40,11 +40,6 @@ public:
      */
     void update(const Dungeon&);
 
-    /**
-     * @brief Take a turn, based on their AI.
-     */
-    void actAI();
-
     bool isVisible() const;
     void setVisible(bool);
 
@@ -52,6 +47,11 @@ public:
     void setBoardPos(u8 x, u8 y);
     void setBoardPos(const BoardPos&);
 
+    /**
+     * @brief Direction they're facing.
+     */
+    Direction9 getDirection() const;
+
 protected:
     void _act(const MonsterAction& action);
 
@@ -14,6 +14,7 @@
 #include "bn_sprite_ptr.h"
 
 #include "constants.hpp"
+#include "game/BoardPos.hpp"
 #include "game/Direction9.hpp"
 
 namespace mp::game
@@ -48,21 +49,29 @@ public:
 
     /**
      * @brief Start action, including moving & sprite animation.
+     * Moving starts on the next `update()`, which takes `Dungeon::getMoveFrames()` of the current turn.
      */
     void startActions(Type animType, Direction9);
 
+    /**
+     * @brief Place the sprite on the board, relative to the player who the camera is centered on.
+     */
+    void placeAt(const BoardPos& pos, const BoardPos& playerPos);
+
+    Direction9 getDirection() const;
+
 private:
     void _initGraphics(const bn::camera_ptr&);
 
     void _updateAnimation(const Dungeon& dungeon);
-    void _updateMoveAction();
+    void _updateMoveAction(const Dungeon& dungeon);
 
     /**
      * @brief Check if the same animation is ongoing, and if not, start the animation.
      */
     void _startAnimation(Type animType, Direction9);
 
-    void _startMoveAction(Direction9);
+    void _startMoveAction(s32 moveFrames);
 
     auto _getAnimation(Type, Direction9) -> bn::sprite_animate_action<consts::MOB_ANIM_MAX_KEYFRAMES>;
 
@@ -81,6 +90,8 @@ private:
     bn::sprite_ptr _sprite;
     bn::sprite_animate_action<consts::MOB_ANIM_MAX_KEYFRAMES> _animateAction;
     bn::optional<bn::sprite_move_to_action> _moveAction;
+    // sum of the moves started after the last update, which is more than a tile if it acted twice in a turn.
+    BoardPos _pendingMoveDiff = {0, 0};
 
     Type _animType = Type::IDLE;
     Direction9 _direction = Direction9::DOWN;
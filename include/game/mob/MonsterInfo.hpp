@@ -10,6 +10,7 @@
 
 #include "bn_sprite_item.h"
 
+#include "game/mob/MonsterSpeed.hpp"
 #include "typedefs.hpp"
 
 namespace mp::game::mob
@@ -30,10 +31,14 @@ public:
 public:
     const MonsterSpecies species;
     const bn::sprite_item& spriteItem;
+    const s16 maxHp;
+    const MonsterSpeed speed;
+    const ai::AI& ai;
 
 public:
-    constexpr MonsterInfo(MonsterSpecies species_, const bn::sprite_item& spriteItem_)
-        : species(species_), spriteItem(spriteItem_)
+    constexpr MonsterInfo(MonsterSpecies species_, const bn::sprite_item& spriteItem_, s16 maxHp_,
+                          MonsterSpeed speed_, const ai::AI& ai_)
+        : species(species_), spriteItem(spriteItem_), maxHp(maxHp_), speed(speed_), ai(ai_)
     {
     }
 };
@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "typedefs.hpp"
+
+namespace mp::game::mob
+{
+
+/**
+ * @brief How often a monster acts, compared to the `NORMAL` speed.
+ * DO NOT change order, as indices are used for querying the turn delays in `TurnScheduler`.
+ */
+enum class MonsterSpeed : u8
+{
+    // 1/3 actions
+    VERY_SLOW,
+    // 1/2 actions
+    SLOW,
+    NORMAL,
+    // 2x actions
+    FAST,
+    // 3x actions
+    VERY_FAST,
+
+    TOTAL_SPEEDS
+};
+
+} // namespace mp::game::mob
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+#include "bn_optional.h"
+#include "bn_span.h"
+#include "bn_vector.h"
+
+#include "constants.hpp"
+#include "game/BoardPos.hpp"
+#include "game/mob/MonsterAnimation.hpp"
+#include "game/mob/StatusEffects.hpp"
+#include "game/mob/ai/AIState.hpp"
+#include "typedefs.hpp"
+
+namespace bn
+{
+class camera_ptr;
+}
+
+namespace mp::game
+{
+class Dungeon;
+}
+
+namespace mp::game::mob
+{
+
+enum MonsterSpecies : u8;
+class MonsterAction;
+
+/**
+ * @brief Structure-of-arrays store of the non-player monsters.
+ *
+ * Turn logic (AI & collision) only scans the tight dense arrays of positions, species, HPs, AI states & statuses.
+ * Removing a monster swaps the last one into its place, so the dense arrays never have holes.
+ *
+ * Monsters are referred by `Handle`, which stays valid until that monster is removed.
+ * Animations are kept in a separate pool, indexed by the handle slot, so that they never move.
+ */
+class MonsterTable final
+{
+public:
+    static constexpr s32 MAX_COUNT = consts::DUNGEON_MOB_MAX_COUNT;
+
+    static_assert(MAX_COUNT <= 0x7F);
+
+    struct Handle
+    {
+        static constexpr u8 INVALID_SLOT = 0xFF;
+
+        u8 slot = INVALID_SLOT;
+        u8 generation = 0;
+
+        bool isValid() const
+        {
+            return slot != INVALID_SLOT;
+        }
+
+        bool operator==(const Handle& other) const
+        {
+            return slot == other.slot && generation == other.generation;
+        }
+    };
+
+public:
+    MonsterTable();
+
+    /**
+     * @brief Frame update of every animation.
+     */
+    void update(const Dungeon&);
+
+    /**
+     * @param playerPos where the camera is centered, to place the sprite.
+     */
+    auto add(MonsterSpecies, const BoardPos& pos, const BoardPos& playerPos, const bn::camera_ptr&) -> Handle;
+
+    /**
+     * @brief Remove the monster in O(1), by moving the last monster into its dense index.
+     */
+    void remove(Handle);
+    void removeAt(s32 index);
+
+    void clear();
+
+    bool contains(Handle) const;
+
+    s32 size() const;
+    bool empty() const;
+    bool full() const;
+
+    /**
+     * @brief Dense index of a monster, which changes when another monster is removed.
+     */
+    s32 getIndex(Handle) const;
+    auto getHandle(s32 index) const -> Handle;
+
+    /**
+     * @brief Dense index of the monster with the handle slot, which is used as an actor id of `TurnScheduler`.
+     */
+    s32 getIndexOfSlot(u8 slot) const;
+
+    /**
+     * @brief Find the dense index of the monster on `pos`.
+     * @return `-1` if there's no monster on `pos`.
+     */
+    s32 findIndexAt(const BoardPos& pos) const;
+
+    /**
+     * @brief Apply the action to the monster, including its position & animation.
+     */
+    void act(s32 index, const MonsterAction&);
+
+    void setVisible(bool isVisible);
+
+    auto getPositions() const -> bn::span<const BoardPos>;
+    auto getSpecies() const -> bn::span<const MonsterSpecies>;
+    auto getHps() const -> bn::span<const s16>;
+    auto getHps() -> bn::span<s16>;
+    auto getAIStates() const -> bn::span<const ai::AIState>;
+    auto getAIStates() -> bn::span<ai::AIState>;
+    auto getStatuses() const -> bn::span<const StatusEffects>;
+    auto getStatuses() -> bn::span<StatusEffects>;
+
+    auto getAnimation(s32 index) -> MonsterAnimation&;
+
+private:
+    // dense arrays, indexed by the dense index.
+    bn::vector<BoardPos, MAX_COUNT> _positions;
+    bn::vector<MonsterSpecies, MAX_COUNT> _species;
+    bn::vector<s16, MAX_COUNT> _hps;
+    bn::vector<ai::AIState, MAX_COUNT> _aiStates;
+    bn::vector<StatusEffects, MAX_COUNT> _statuses;
+    // handle slot of each dense index, which is also its animation index.
+    bn::vector<u8, MAX_COUNT> _slots;
+
+    // sparse arrays, indexed by the handle slot.
+    bn::array<s8, MAX_COUNT> _indexOfSlots;
+    bn::array<u8, MAX_COUNT> _generations;
+    bn::array<bn::optional<MonsterAnimation>, MAX_COUNT> _animations;
+    bn::vector<u8, MAX_COUNT> _freeSlots;
+};
+
+} // namespace mp::game::mob
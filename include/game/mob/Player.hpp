@@ -10,7 +10,9 @@
 
 #include "game/mob/Monster.hpp"
 
+#include "game/mob/MonsterSpeed.hpp"
 #include "game/mob/PlayerBelly.hpp"
+#include "game/mob/StatusEffects.hpp"
 
 namespace mp::game
 {
@@ -34,8 +36,22 @@ public:
 
     PlayerBelly& getBelly();
 
+    auto getStatuses() -> StatusEffects&;
+    auto getStatuses() const -> const StatusEffects&;
+
+    /**
+     * @brief Add or remove the hunger status, with the current belly.
+     */
+    void updateHungerStatus();
+
+    /**
+     * @brief Speed in the `TurnScheduler`, which is slowed down while hungry.
+     */
+    auto getSpeed() const -> MonsterSpeed;
+
 private:
     PlayerBelly _belly;
+    StatusEffects _statuses;
 };
 
 } // namespace mp::game::mob
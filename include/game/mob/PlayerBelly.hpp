@@ -20,6 +20,10 @@ namespace mp::game::mob
 
 class PlayerBelly final
 {
+public:
+    // player gets hungry at or below this percent of the max belly.
+    static constexpr s32 HUNGRY_PERCENT = 20;
+
 public:
     PlayerBelly(s32 currentBelly, s32 maxBelly, s32 bellyDecreaseTurns, Hud&);
 
@@ -33,6 +37,11 @@ public:
 
     bool isStarveToDeath() const;
 
+    /**
+     * @brief Belly is low, which slows the player down.
+     */
+    bool isHungry() const;
+
     s32 getMaxBelly() const;
     void setMaxBelly(s32 belly);
 
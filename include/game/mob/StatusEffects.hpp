@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "bn_array.h"
+#include "bn_span.h"
+
+#include "typedefs.hpp"
+
+namespace mp::game::mob
+{
+
+/**
+ * @brief Status effect kind.
+ * DO NOT change order, as indices are used for the bit of the flags & the saved data.
+ */
+enum StatusEffectKind : u8
+{
+    // can't act, after stepping on a banana peel.
+    SLIP = 0,
+    // can't act.
+    SLEEP,
+    // moves to a random direction.
+    CONFUSION,
+    // player is slowed down, while their belly is low.
+    HUNGER,
+
+    // total status effects count
+    TOTAL_STATUS_EFFECTS
+};
+
+/**
+ * @brief Active status effects of an actor, which are a bitmask of `StatusEffectKind` & the turns left of each.
+ *
+ * Every effect is ticked with a plain loop over the bits, so no virtual call is involved per effect.
+ */
+class StatusEffects final
+{
+public:
+    static_assert(TOTAL_STATUS_EFFECTS <= 8, "Flags don't fit in a byte");
+
+    // effect with these turns never wears off by ticking, so it must be removed explicitly.
+    static constexpr u8 ENDLESS_TURNS = 0xFF;
+
+    // flags, followed by the turns left of each effect.
+    static constexpr s32 SERIALIZED_SIZE = 1 + TOTAL_STATUS_EFFECTS;
+    using Serialized = bn::array<u8, SERIALIZED_SIZE>;
+
+public:
+    /**
+     * @brief Add the effect for `turns`.
+     * If it's already active, the longer turns are kept.
+     */
+    void add(StatusEffectKind, u8 turns);
+    void remove(StatusEffectKind);
+    void clear();
+
+    bool has(StatusEffectKind) const;
+    bool any() const;
+
+    /**
+     * @return `0` if the effect is not active.
+     */
+    u8 getTurns(StatusEffectKind) const;
+
+    /**
+     * @brief Slipped or asleep, so they can't act in this turn.
+     */
+    bool isIncapacitated() const;
+
+    /**
+     * @brief Progress a turn, which decreases the turns left of the active effects, and removes the worn off ones.
+     */
+    void tick();
+
+    /**
+     * @brief Tick the status effects of every actor in one linear pass.
+     */
+    static void tickAll(bn::span<StatusEffects>);
+
+    auto serialize() const -> Serialized;
+    static auto deserialize(const Serialized&) -> StatusEffects;
+
+private:
+    u8 _flags = 0;
+    bn::array<u8, TOTAL_STATUS_EFFECTS> _turns = {};
+};
+
+} // namespace mp::game::mob
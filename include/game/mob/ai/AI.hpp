@@ -8,11 +8,89 @@
 
 #pragma once
 
+#include "bn_span.h"
+
+#include "game/BoardPos.hpp"
+#include "game/Direction9.hpp"
+#include "game/mob/ai/AIState.hpp"
+#include "typedefs.hpp"
+
+namespace iso_bn
+{
+class random;
+}
+
 namespace mp::game::mob::ai
 {
 
-class AI
+enum class Condition : u8
 {
+    ALWAYS,
+    // player is within the sight range.
+    SEE_PLAYER,
+    // player is out of the sight range.
+    LOST_PLAYER,
+    // HP is at or below the low HP percent.
+    LOW_HP,
+    // 1 in 8 chance.
+    RANDOM,
+};
+
+/**
+ * @brief Move from the state `from` to `to`, when the `condition` is met.
+ */
+struct Transition
+{
+    AIState from;
+    Condition condition;
+    AIState to;
+};
+
+/**
+ * @brief What a monster knows when it thinks.
+ */
+struct Senses
+{
+    BoardPos pos;
+    BoardPos playerPos;
+    s16 hp;
+    s16 maxHp;
+};
+
+/**
+ * @brief Behavior table of a monster species, which is constexpr & placed in ROM.
+ *
+ * Each turn, the first matching transition from the current state is taken, and the new state decides the move.
+ * No virtual calls nor heap allocation are involved, so that every monster can think in a small part of a frame.
+ */
+class AI final
+{
+public:
+    constexpr AI(bn::span<const Transition> transitions, u8 sightRange, u8 lowHpPercent)
+        : _transitions(transitions), _sightRange(sightRange), _lowHpPercent(lowHpPercent)
+    {
+    }
+
+    /**
+     * @brief Update the `state` with the transitions, and decide the direction to move.
+     * @return `Direction9::NONE` if it stays.
+     */
+    Direction9 think(AIState& state, const Senses&, iso_bn::random&) const;
+
+#ifdef MP_DEBUG
+    /**
+     * @brief Profile thinking of `MonsterTable::MAX_COUNT` monsters at once.
+     */
+    static void benchmarkThink(iso_bn::random& rng);
+#endif
+
+private:
+    bool _isMet(Condition, const Senses&, iso_bn::random&) const;
+
+private:
+    bn::span<const Transition> _transitions;
+    u8 _sightRange;
+    u8 _lowHpPercent;
 };
 
 } // namespace mp::game::mob::ai
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "typedefs.hpp"
+
+namespace mp::game::mob::ai
+{
+
+/**
+ * @brief Per-monster AI state, which is kept in `MonsterTable`.
+ */
+enum class AIState : u8
+{
+    SLEEP,
+    WANDER,
+    CHASE,
+    FLEE,
+
+    TOTAL_STATES
+};
+
+} // namespace mp::game::mob::ai
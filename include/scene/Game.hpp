@@ -10,6 +10,7 @@
 
 #include "scene/IScene.hpp"
 
+#include "Arena.hpp"
 #include "game/Dungeon.hpp"
 
 namespace mp
@@ -32,9 +33,14 @@ public:
 
     [[nodiscard]] bn::optional<SceneType> update() final;
 
+    auto getArena() const -> const Arena* final;
+
 private:
     iso_bn::random& _rng;
-    game::Dungeon _dungeon;
+
+    // every scene-lifetime buffer of the game, which is freed as a whole on the scene switch.
+    Arena _arena;
+    game::Dungeon& _dungeon;
 };
 
 } // namespace mp::scene
@@ -12,6 +12,11 @@
 
 #include "scene/SceneType.hpp"
 
+namespace mp
+{
+class Arena;
+}
+
 namespace mp::scene
 {
 
@@ -21,6 +26,14 @@ public:
     virtual ~IScene() = default;
 
     [[nodiscard]] virtual bn::optional<SceneType> update() = 0;
+
+    /**
+     * @brief Arena that holds the scene-lifetime buffers, if the scene has one.
+     */
+    virtual auto getArena() const -> const Arena*
+    {
+        return nullptr;
+    }
 };
 
 } // namespace mp::scene
@@ -20,6 +20,7 @@
 #include "bn_utility.h"
 
 #include "Settings.hpp"
+#include "game/LogTextKind.hpp"
 #include "game/item/ItemKind.hpp"
 
 namespace mp::texts
@@ -27,6 +28,9 @@ namespace mp::texts
 
 using LangTexts = bn::array<bn::string_view, Settings::TOTAL_LANGUAGES>;
 
+// for use in drawing numbers with glyph ids.
+inline constexpr LangTexts NUMBER_GLYPHS = {"0123456789", "0123456789"};
+
 inline constexpr LangTexts BELLY = {"Belly", "만복도"};
 
 inline constexpr LangTexts ITEM_USE_HINT = {"L+A: Use", "L+A: 사용"};
@@ -45,4 +49,12 @@ inline constexpr bn::array<bn::pair<LangTexts, LangTexts>, game::item::TOTAL_ITE
     },
 };
 
+// for use in MessageLog class.
+// `{}` is replaced with the argument of the message.
+inline constexpr bn::array<LangTexts, game::TOTAL_LOG_TEXTS> LOG_TEXTS = {
+    LangTexts{"Picked up {}.", "{}을(를) 주웠다."},
+    LangTexts{"Used {}.", "{}을(를) 사용했다."},
+    LangTexts{"Threw {}.", "{}을(를) 던졌다."},
+};
+
 } // namespace mp::texts
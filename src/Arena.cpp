@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "Arena.hpp"
+
+#include "bn_algorithm.h"
+#include "bn_log.h"
+#include "bn_memory.h"
+
+namespace mp
+{
+
+Arena::Scope::Scope(Arena& arena)
+    : _arena(arena), _usedBytes(arena._usedBytes), _finalizersCount(arena._finalizers.size())
+{
+}
+
+Arena::Scope::~Scope()
+{
+    _arena._release(_usedBytes, _finalizersCount);
+}
+
+Arena::Arena(s32 capacity, const char* name)
+    : _name(name), _buffer(static_cast<u8*>(bn::memory::ewram_alloc(capacity))), _capacity(capacity)
+{
+    BN_ASSERT(_buffer, "Arena(", _name, ") alloc failed: ", capacity, " bytes (",
+              bn::memory::available_alloc_ewram(), " bytes available)");
+}
+
+Arena::~Arena()
+{
+    _release(0, 0);
+
+#ifdef MP_DEBUG
+    BN_LOG("Arena(", _name, ") peak: ", _peakBytes, " / ", _capacity, " bytes");
+#endif
+
+    bn::memory::ewram_free(_buffer);
+}
+
+void* Arena::allocate(s32 bytes, s32 alignment)
+{
+    BN_ASSERT(bytes >= 0, "Invalid bytes(", bytes, ")");
+    BN_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid alignment(", alignment, ")");
+
+    // `ewram_alloc()` is 4 bytes aligned, and nothing here needs more than that.
+    BN_ASSERT(alignment <= 4, "Alignment(", alignment, ") over 4 bytes is not supported");
+
+    const s32 begin = (_usedBytes + alignment - 1) & ~(alignment - 1);
+    BN_ASSERT(begin + bytes <= _capacity, "Arena(", _name, ") is full: ", begin + bytes, " / ", _capacity, " bytes");
+
+    _usedBytes = begin + bytes;
+    _peakBytes = bn::max(_peakBytes, _usedBytes);
+
+    return _buffer + begin;
+}
+
+s32 Arena::getCapacity() const
+{
+    return _capacity;
+}
+
+s32 Arena::getUsedBytes() const
+{
+    return _usedBytes;
+}
+
+s32 Arena::getPeakBytes() const
+{
+    return _peakBytes;
+}
+
+void Arena::_release(s32 usedBytes, s32 finalizersCount)
+{
+    while (_finalizers.size() > finalizersCount)
+    {
+        const Finalizer& finalizer = _finalizers.back();
+        finalizer.destroy(finalizer.object);
+        _finalizers.pop_back();
+    }
+
+    _usedBytes = usedBytes;
+}
+
+} // namespace mp
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "DigitText.hpp"
+
+#include "bn_assert.h"
+#include "bn_sprite_font.h"
+#include "bn_sprite_item.h"
+
+namespace mp
+{
+
+namespace
+{
+// sprite fonts start their glyphs from ' '(U+0020).
+constexpr s32 DIGIT_ZERO_GRAPHICS_INDEX = '0' - ' ';
+} // namespace
+
+DigitStrip::DigitStrip(const bn::sprite_font& font)
+    : _palette(font.item().palette_item().create_palette()), _shapeSize(font.item().shape_size())
+{
+    const auto& widths = font.character_widths_ref();
+
+    for (s32 digit = 0; digit < DIGITS_COUNT; ++digit)
+    {
+        const s32 graphicsIndex = DIGIT_ZERO_GRAPHICS_INDEX + digit;
+        _tiles.push_back(font.item().tiles_item().create_tiles(graphicsIndex));
+
+        const s32 width = widths.empty() ? _shapeSize.width() : widths[graphicsIndex];
+        _advances[digit] = (s8)(width + font.character_spacing());
+    }
+}
+
+auto DigitStrip::getTiles(s32 digit) const -> const bn::sprite_tiles_ptr&
+{
+    BN_ASSERT(0 <= digit && digit < DIGITS_COUNT, "Invalid digit(", digit, ")");
+
+    return _tiles[digit];
+}
+
+auto DigitStrip::getPalette() const -> const bn::sprite_palette_ptr&
+{
+    return _palette;
+}
+
+auto DigitStrip::getShapeSize() const -> const bn::sprite_shape_size&
+{
+    return _shapeSize;
+}
+
+s32 DigitStrip::getAdvance(s32 digit) const
+{
+    BN_ASSERT(0 <= digit && digit < DIGITS_COUNT, "Invalid digit(", digit, ")");
+
+    return _advances[digit];
+}
+
+DigitText::DigitText(const DigitStrip& strip, const bn::fixed_point& rightPos, s32 bgPriority)
+    : _strip(strip), _rightPos(rightPos), _bgPriority(bgPriority)
+{
+}
+
+s32 DigitText::getNumber() const
+{
+    return _number;
+}
+
+void DigitText::setNumber(s32 number)
+{
+    BN_ASSERT(0 <= number && number < 10'000, "number(", number, ") can't be shown with ", MAX_DIGITS, " digits");
+
+    if (number == _number)
+        return;
+    _number = number;
+
+    // least significant digit first
+    bn::array<s8, MAX_DIGITS> digits;
+    s32 digitsCount = 0;
+    do
+    {
+        digits[digitsCount++] = (s8)(number % 10);
+        number /= 10;
+    } while (number > 0);
+
+    _placeDigits(digits, digitsCount);
+}
+
+bool DigitText::isVisible() const
+{
+    return _isVisible;
+}
+
+void DigitText::setVisible(bool isVisible)
+{
+    _isVisible = isVisible;
+    for (auto& sprite : _digitSprites)
+        sprite.set_visible(isVisible);
+}
+
+void DigitText::_placeDigits(const bn::array<s8, MAX_DIGITS>& digits, s32 digitsCount)
+{
+    // sprites are only created when the number gets longer.
+    while (_digitSprites.size() > digitsCount)
+        _digitSprites.pop_back();
+    while (_digitSprites.size() < digitsCount)
+    {
+        bn::sprite_ptr sprite = bn::sprite_ptr::create(_rightPos, _strip.getShapeSize(), _strip.getTiles(0),
+                                                       _strip.getPalette());
+        sprite.set_bg_priority(_bgPriority);
+        sprite.set_visible(_isVisible);
+        _digitSprites.push_back(bn::move(sprite));
+    }
+
+    s32 textWidth = 0;
+    for (s32 i = 0; i < digitsCount; ++i)
+        textWidth += _strip.getAdvance(digits[i]);
+
+    // most significant digit first, from left to right.
+    bn::fixed x = _rightPos.x() - textWidth + _strip.getShapeSize().width() / 2;
+    for (s32 i = 0; i < digitsCount; ++i)
+    {
+        const s32 digit = digits[digitsCount - 1 - i];
+        bn::sprite_ptr& sprite = _digitSprites[i];
+
+        sprite.set_tiles(_strip.getTiles(digit));
+        sprite.set_x(x);
+        x += _strip.getAdvance(digit);
+    }
+}
+
+} // namespace mp
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "MemoryBudget.hpp"
+
+#include "bn_log.h"
+
+#include "game/Dungeon.hpp"
+#include "game/DungeonBg.hpp"
+#include "game/DungeonFloor.hpp"
+#include "game/DungeonGenerator.hpp"
+#include "game/Hud.hpp"
+#include "game/MiniMap.hpp"
+#include "game/item/Item.hpp"
+#include "game/mob/Monster.hpp"
+#include "game/mob/MonsterTable.hpp"
+#include "typedefs.hpp"
+
+namespace mp::budget
+{
+
+namespace
+{
+
+/**
+ * @brief `sizeof` of a game object, with its budget checked by `static_assert`.
+ */
+struct Entry
+{
+    const char* name;
+    s32 size;
+    s32 budget;
+};
+
+/**
+ * @brief Make an entry, failing the build if `Type` exceeds `Budget` bytes.
+ * Raise the budget only when the growth is intended, as every one of these lives in a scene arena or a fixed list.
+ */
+template <typename Type, s32 Budget>
+constexpr Entry makeEntry(const char* name)
+{
+    static_assert(sizeof(Type) <= Budget, "sizeof(Type) exceeds its budget, see `Type` and `Budget` above");
+
+    return {name, (s32)sizeof(Type), Budget};
+}
+
+// budgets are the sizes on the right, plus 25% headroom rounded up to 512 bytes.
+// small ones get 50% rounded up to 32 bytes instead, as their size depends more on the butano internals.
+// the sizes are counted by hand from the members, not measured from a build:
+// replace them with the sizes logged by `logEntries()` (select + start) on the next debug build.
+constexpr Entry ENTRIES[] = {
+    makeEntry<game::Dungeon, 23 * 1024>("Dungeon"),                  // 18760, with 255 glyphs per language
+    makeEntry<game::DungeonFloor, 11 * 1024>("DungeonFloor"),        // 8716
+    makeEntry<game::DungeonBg, 5 * 512>("DungeonBg"),                // 2080
+    makeEntry<game::MiniMap, 640>("MiniMap"),                        // 412
+    makeEntry<game::Hud, 352>("Hud"),                                // 224
+    makeEntry<game::mob::Monster, 160>("Monster"),                   // 100
+    makeEntry<game::mob::MonsterTable, 9 * 512>("MonsterTable"),     // 3424
+    makeEntry<game::item::Item, 32>("Item"),                         // 16
+    makeEntry<game::DungeonGenerator, 6 * 1024>("DungeonGenerator"), // 4628
+};
+
+} // namespace
+
+#ifdef MP_DEBUG
+void logEntries()
+{
+    BN_LOG("=== memory budget ===");
+    for (const Entry& entry : ENTRIES)
+        BN_LOG(entry.name, ": ", entry.size, " / ", entry.budget, " bytes");
+}
+#endif
+
+} // namespace mp::budget
@@ -17,6 +17,11 @@
 namespace mp
 {
 
+namespace
+{
+constexpr const bn::sprite_font* FONTS[TextGen::TOTAL_FONTS] = {&galmuri7_sprite_font, &galmuri9_sprite_font};
+}
+
 TextGen::TextGen()
     : _textGens({bn::sprite_text_generator(galmuri7_sprite_font), bn::sprite_text_generator(galmuri9_sprite_font)})
 {
@@ -29,4 +34,22 @@ auto TextGen::get(FontKind fontKind) -> bn::sprite_text_generator&
     return _textGens[fontKind];
 }
 
+auto TextGen::getFont(FontKind fontKind) const -> const bn::sprite_font&
+{
+    BN_ASSERT(0 <= fontKind && fontKind < TOTAL_FONTS, "Invalid fontKind(", fontKind, ")");
+
+    return *FONTS[fontKind];
+}
+
+auto TextGen::getDigitStrip(FontKind fontKind) -> const DigitStrip&
+{
+    BN_ASSERT(0 <= fontKind && fontKind < TOTAL_FONTS, "Invalid fontKind(", fontKind, ")");
+
+    auto& digitStrip = _digitStrips[fontKind];
+    if (!digitStrip)
+        digitStrip.emplace(*FONTS[fontKind]);
+
+    return *digitStrip;
+}
+
 } // namespace mp
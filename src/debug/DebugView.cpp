@@ -12,7 +12,11 @@
 #include "bn_format.h"
 #include "bn_keypad.h"
 
+#include "Arena.hpp"
+#include "MemoryBudget.hpp"
 #include "TextGen.hpp"
+#include "debug/StackPaint.hpp"
+#include "scene/IScene.hpp"
 #include "texts.hpp"
 
 namespace mp::debug
@@ -33,7 +37,7 @@ DebugView::DebugView(TextGen& textGen) : _textGen(textGen)
     _resetCounter();
 }
 
-void DebugView::update()
+void DebugView::update(const scene::IScene* scene)
 {
     if ((bn::keypad::start_held() && bn::keypad::select_pressed()) ||
         (bn::keypad::select_held() && bn::keypad::start_pressed()))
@@ -58,6 +62,7 @@ void DebugView::update()
             (bn::fixed(EWRAM_BYTES - bn::memory::available_alloc_ewram()) / EWRAM_BYTES * 100).round_integer();
         const s32 iwFree = IWRAM_BYTES - bn::memory::used_static_iwram() - bn::memory::used_stack_iwram();
         const s32 ewFree = bn::memory::available_alloc_ewram();
+        const s32 stackMax = StackPaint::getHighWaterMark();
 
         auto& textGen = _textGen.get(TextGen::FontKind::GALMURI_9);
         textGen.set_alignment(bn::sprite_text_generator::alignment_type::LEFT);
@@ -65,6 +70,17 @@ void DebugView::update()
         textGen.generate(X_POS, -50, bn::format<10>("vbl {}%", vblank), _usageSprites);
         textGen.generate(X_POS, -40, bn::format<17>("  iw {}% {}", iwUse, iwFree), _usageSprites);
         textGen.generate(X_POS, -30, bn::format<18>("  ew {}% {}", ewUse, ewFree), _usageSprites);
+        textGen.generate(X_POS, -20, bn::format<18>("stk max {}", stackMax), _usageSprites);
+        textGen.generate(X_POS, -10, bn::format<18>("iw static {}", bn::memory::used_static_iwram()),
+                         _usageSprites);
+
+        // scene arena is the scene's share of EWRAM.
+        if (const Arena* arena = (scene ? scene->getArena() : nullptr))
+        {
+            textGen.generate(X_POS, 0, bn::format<22>("scn {} / {}", arena->getUsedBytes(), arena->getCapacity()),
+                             _usageSprites);
+            textGen.generate(X_POS, 10, bn::format<18>("scn peak {}", arena->getPeakBytes()), _usageSprites);
+        }
 
         _resetCounter();
     }
@@ -82,6 +98,8 @@ void DebugView::_setVisible(bool isVisible)
         auto& textGen = _textGen.get(TextGen::FontKind::GALMURI_9);
         textGen.set_alignment(bn::sprite_text_generator::alignment_type::LEFT);
         textGen.generate(X_POS, -70, "     use / free", _headingSprites);
+
+        budget::logEntries();
     }
     else
     {
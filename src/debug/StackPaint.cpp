@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "debug/StackPaint.hpp"
+
+#include "bn_assert.h"
+#include "bn_memory.h"
+
+namespace mp::debug
+{
+
+#ifdef MP_DEBUG
+
+namespace
+{
+constexpr u32 PAINT_WORD = 0xDEADBEEF;
+constexpr uintptr_t IWRAM_START = 0x0300'0000;
+
+// leave some words below the current stack pointer, for the frame of `paint()` itself.
+constexpr s32 PAINT_MARGIN_WORDS = 32;
+
+// lowest painted word, and the stack top (where the stack starts growing down from).
+volatile u32* paintBegin = nullptr;
+uintptr_t stackTop = 0;
+} // namespace
+
+void StackPaint::paint()
+{
+    volatile u32 stackMarker = 0;
+    const uintptr_t stackPointer = reinterpret_cast<uintptr_t>(&stackMarker);
+    stackTop = stackPointer + bn::memory::used_stack_iwram();
+
+    // from the end of the static IWRAM data, to slightly below the current stack pointer.
+    const uintptr_t begin = (IWRAM_START + bn::memory::used_static_iwram() + 3) & ~uintptr_t(3);
+    const uintptr_t end = (stackPointer & ~uintptr_t(3)) - PAINT_MARGIN_WORDS * sizeof(u32);
+    BN_ASSERT(begin < end, "No free IWRAM to paint");
+
+    paintBegin = reinterpret_cast<volatile u32*>(begin);
+    for (volatile u32* word = paintBegin; reinterpret_cast<uintptr_t>(word) < end; ++word)
+        *word = PAINT_WORD;
+}
+
+s32 StackPaint::getHighWaterMark()
+{
+    BN_ASSERT(paintBegin, "Stack was not painted");
+
+    // stack grows down, so the first overwritten word from the bottom is the deepest one.
+    const volatile u32* word = paintBegin;
+    while (reinterpret_cast<uintptr_t>(word) < stackTop && *word == PAINT_WORD)
+        ++word;
+
+    return (s32)(stackTop - reinterpret_cast<uintptr_t>(word));
+}
+
+#endif
+
+} // namespace mp::debug
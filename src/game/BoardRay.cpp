@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/BoardRay.hpp"
+
+#include "bn_assert.h"
+
+namespace mp::game
+{
+
+BoardRay::BoardRay(const BoardPos& from, const BoardPos& to)
+    : _pos(from), _to(to), _stepX((from.x < to.x) ? 1 : -1), _stepY((from.y < to.y) ? 1 : -1),
+      _dx((s16)((from.x < to.x) ? to.x - from.x : from.x - to.x)),
+      _dy((s16)-((from.y < to.y) ? to.y - from.y : from.y - to.y)), _error((s16)(_dx + _dy))
+{
+}
+
+bool BoardRay::done() const
+{
+    return _pos == _to;
+}
+
+auto BoardRay::next() -> const BoardPos&
+{
+    BN_ASSERT(!done(), "BoardRay already reached its end");
+
+    const s16 doubleError = (s16)(2 * _error);
+    if (doubleError >= _dy)
+    {
+        _error += _dy;
+        _pos.x += _stepX;
+    }
+    if (doubleError <= _dx)
+    {
+        _error += _dx;
+        _pos.y += _stepY;
+    }
+    return _pos;
+}
+
+} // namespace mp::game
@@ -9,35 +9,82 @@
 #include "game/Dungeon.hpp"
 
 #include "bn_assert.h"
+#include "bn_config_profiler.h"
+#include "bn_display.h"
 #include "bn_keypad.h"
+#include "bn_log.h"
 #include "iso_bn_random.h"
 
+#include "Arena.hpp"
 #include "constants.hpp"
+#include "game/BoardRay.hpp"
+#include "game/DungeonGenerator.hpp"
 #include "game/MetaTileset.hpp"
 #include "game/item/ItemInfo.hpp"
 #include "game/item/ItemKind.hpp"
 #include "game/item/ability/ItemAbility.hpp"
 #include "game/mob/MonsterAction.hpp"
+#include "game/mob/MonsterInfo.hpp"
 #include "game/mob/MonsterSpecies.hpp"
+#include "game/mob/StatusEffects.hpp"
+#include "game/mob/ai/AI.hpp"
 
 namespace mp::game
 {
 
-Dungeon::Dungeon(iso_bn::random& rng, TextGen& textGen, Settings& settings)
-    : _rng(rng), _settings(settings), _camera(bn::camera_ptr::create(consts::INIT_CAM_POS)), _bg(_camera),
-      _hud(textGen, settings), _itemUse(_hud), _player({0, 0}, _camera, _hud)
+namespace
+{
+
+// where a confused actor moves to.
+Direction9 _randomDirection(iso_bn::random& rng)
+{
+    return (Direction9)(rng.get_int(8) + 1);
+}
+
+// 90 degrees turn of a direction, which is not `NONE`.
+Direction9 _turnLeft(Direction9 dir)
+{
+    return (Direction9)((dir + 5) % 8 + 1);
+}
+
+Direction9 _turnRight(Direction9 dir)
+{
+    return (Direction9)((dir + 1) % 8 + 1);
+}
+
+bool _isDiagonal(Direction9 dir)
+{
+    return dir % 2 == 0;
+}
+
+s32 _abs(s32 value)
+{
+    return (value < 0) ? -value : value;
+}
+
+constexpr u8 RUN_LEFT_SIDE = 1 << 0;
+constexpr u8 RUN_RIGHT_SIDE = 1 << 1;
+
+} // namespace
+
+Dungeon::Dungeon(Arena& arena, iso_bn::random& rng, TextGen& textGen, Settings& settings)
+    : _arena(arena), _rng(rng), _settings(settings), _camera(bn::camera_ptr::create(consts::INIT_CAM_POS)),
+      _bg(_camera, MetaTilesetKind::PLACEHOLDER, arena), _miniMap(arena), _hud(textGen, settings),
+      _log(textGen, settings), _itemUse(_hud), _player({0, 0}, _camera, _hud)
 {
 #ifdef MP_DEBUG
+    // test has its own rng, so that it doesn't change the gameplay rng sequence.
+    iso_bn::random testRng;
+    DungeonBg::testCellMapper(testRng);
     _testMapGen();
 #endif
 
     _hud.setBelly(_player.getBelly().getCurrentBelly(), _player.getBelly().getMaxBelly());
 
-    // TODO: Move mini-map to seperate screen
     _miniMap.updateBgPos(_player);
-    // _miniMap.setVisible(true);
 
     _hud.setVisible(true);
+    _log.setVisible(true);
     _player.setVisible(true);
     _bg.setVisible(true);
 }
@@ -47,7 +94,10 @@ auto Dungeon::update() -> bn::optional<scene::SceneType>
     bool isPlayerAlive = _progressTurn();
 
     _player.update(*this);
+    _monsters.update(*this);
     _miniMap.update();
+    _log.update();
+    _itemUse.update();
 
     if (_camMoveAction)
         _updateBgScroll();
@@ -63,112 +113,465 @@ bool Dungeon::isTurnOngoing() const
     return _camMoveAction.has_value() || _itemUse.isOngoing();
 }
 
+s32 Dungeon::getMoveFrames() const
+{
+    return _moveFrames;
+}
+
 #ifdef MP_DEBUG
 void Dungeon::_testMapGen()
 {
     _player.setBoardPos(DungeonFloor::COLUMNS / 2, DungeonFloor::ROWS / 2);
     _miniMap.updateBgPos(_player);
 
-    _floor.generate(_rng);
+    _floor.generate(_rng, _arena);
+    BN_LOG("game arena: ", _arena.getUsedBytes(), " bytes used, ", _arena.getPeakBytes(), " bytes peak (of ",
+           _arena.getCapacity(), ")");
+    _bg.setMetaTileset(MetaTileset::fromKind(MetaTilesetKind::PLACEHOLDER), _floor);
+#if BN_CFG_PROFILER_ENABLED
+    // benchmarks have their own rng, so that they don't change the gameplay rng sequence.
+    iso_bn::random benchmarkRng;
+    DungeonGenerator::benchmarkKernels(benchmarkRng);
+    mob::ai::AI::benchmarkThink(benchmarkRng);
+#endif
     _bg.redrawAll(_floor, _player);
     _miniMap.redrawAll(_floor);
 
+    _miniMap.clearStamps();
+    _monsters.clear();
+    _scheduler.clear();
+    _mobOccupancy.clear();
     _items.clear();
-    _items.emplace_front(item::ItemKind::BANANA, _player.getBoardPos() + BoardPos{0, -2}, _player, _camera);
+    _itemOccupancy.clear();
+    _items.emplace_front(item::ItemRecord{item::ItemKind::BANANA}, _player.getBoardPos() + BoardPos{0, -2}, _player,
+                         _camera);
+    _itemOccupancy.set(_items.front().getBoardPos());
+    _miniMap.addStamp(MiniMap::StampKind::ITEM, _items.front().getBoardPos(), _floor);
+
+    const BoardPos monsterPos = _player.getBoardPos() + BoardPos{2, 0};
+    if (_floor.getFloorTypeOf(monsterPos) != DungeonFloor::Type::WALL)
+        _spawnMonster(mob::MonsterSpecies::LEMMAS, monsterPos);
+}
+
+void Dungeon::_runBenchmarks()
+{
+#if BN_CFG_PROFILER_ENABLED
+    _bg.benchmarkVariants(_floor, _player);
+    _bg.benchmarkScrollRedraw(_floor, _player);
+#endif
 }
 #endif
 
 bool Dungeon::_progressTurn()
 {
-    // Don't receive any input if the turn is ongoing.
+    // Don't receive any input if the floor is not shown yet.
+    if (_bg.isMetaTilesetLoading())
+        return true;
+
+    // latch the first order given while the turn is ongoing, and run it as soon as the turn ends.
     if (isTurnOngoing())
+    {
+        if (_latchedCommand.type == Command::Type::NONE)
+            _latchedCommand = _readCommand(true);
         return true;
+    }
+
+    // map view doesn't progress the turn. (select + start is reserved for the debug view)
+    if (bn::keypad::start_pressed() && !bn::keypad::select_held())
+        _setMapViewOpened(!_miniMap.isVisible());
+    if (_miniMap.isVisible())
+    {
+        _latchedCommand = Command();
+        _runDirection = Direction9::NONE;
+        if (bn::keypad::l_pressed())
+            _miniMap.zoomOut();
+        else if (bn::keypad::r_pressed())
+            _miniMap.zoomIn();
+        return true;
+    }
 
 #ifdef MP_DEBUG
     if (bn::keypad::select_held() && bn::keypad::l_pressed())
         _testMapGen();
     if (bn::keypad::select_held() && bn::keypad::r_pressed())
-        _miniMap.setVisible(!_miniMap.isVisible());
+        _runBenchmarks();
     if (bn::keypad::select_held() && bn::keypad::right_pressed())
         _settings.setLang((_settings.getLang() == Settings::ENGLISH) ? Settings::KOREAN : Settings::ENGLISH);
 #endif
 
-    bool isPlayerAlive = true;
+    Command command = _latchedCommand;
+    _latchedCommand = Command();
+    if (command.type == Command::Type::NONE)
+        command = _readCommand(false);
 
-    // player movement (with mini-map movement)
-    if (bn::keypad::left_held() || bn::keypad::right_held() || bn::keypad::up_held() || bn::keypad::down_held())
+    // keep running while B is held, unless another order is given.
+    if (_runDirection != Direction9::NONE)
     {
-        using ActionType = mob::MonsterAction::Type;
-        using Dir9 = Direction9;
+        if (command.type == Command::Type::NONE && bn::keypad::b_held())
+            command = Command{Command::Type::MOVE, _runDirection, true};
+        else
+            _runDirection = Direction9::NONE;
+    }
+
+    return _runCommand(command);
+}
+
+auto Dungeon::_readCommand(bool isLatching) const -> Command
+{
+    using Type = Command::Type;
+
+    if (bn::keypad::l_held())
+    {
+        if (bn::keypad::b_pressed())
+            return Command{Type::SELECT_NEXT_ITEM};
+        if (bn::keypad::a_pressed())
+            return Command{Type::USE_ITEM};
+        if (bn::keypad::r_pressed())
+            return Command{Type::TOSS_ITEM};
+    }
+    else if (bn::keypad::a_pressed())
+        return Command{Type::WAIT};
+
+    // run starts with a direction pressed while B is held, and goes on by itself.
+    const bool isRunning = !bn::keypad::l_held() && bn::keypad::b_held();
+
+    // a held direction is read again when the turn ends, so only a new press is latched.
+    const bool isDirectionInput =
+        (isLatching || isRunning)
+            ? (bn::keypad::left_pressed() || bn::keypad::right_pressed() || bn::keypad::up_pressed() ||
+               bn::keypad::down_pressed())
+            : (bn::keypad::left_held() || bn::keypad::right_held() || bn::keypad::up_held() || bn::keypad::down_held());
+
+    // opposite keys held together cancel out each other.
+    if (isDirectionInput)
+        if (const Direction9 inputDirection = getDirectionFromKeyHold(); inputDirection != Direction9::NONE)
+            return Command{Type::MOVE, inputDirection, isRunning};
+
+    return Command();
+}
+
+bool Dungeon::_runCommand(const Command& command)
+{
+    using CommandType = Command::Type;
+    using ActionType = mob::MonsterAction::Type;
 
-        const Dir9 inputDirection = getDirectionFromKeyHold();
+    _moveFrames = consts::ACTOR_MOVE_FRAMES;
 
-        // ignore diagonal inputs, as diagonal movements are not allowed in this game.
-        if (inputDirection == Dir9::UP || inputDirection == Dir9::DOWN || inputDirection == Dir9::LEFT ||
-            inputDirection == Dir9::RIGHT)
+    if (command.type == CommandType::NONE)
+        return true;
+
+    // slipped or asleep player can't act, so waiting just passes the turn.
+    if (_player.getStatuses().isIncapacitated())
+    {
+        _runDirection = Direction9::NONE;
+        if (command.type != CommandType::WAIT)
+            return true;
+
+        const bool isAlive = _player.actPlayer(mob::MonsterAction(_player.getDirection(), ActionType::DO_NOTHING));
+        _progressMonsterTurns();
+        return isAlive;
+    }
+
+    bool isPlayerAlive = true;
+    bool isTurnSpent = false;
+
+    switch (command.type)
+    {
+    // player movement (with mini-map movement)
+    case CommandType::MOVE: {
+        Direction9 moveDir = command.direction;
+        bool isRunning = command.isRunning;
+        if (_player.getStatuses().has(mob::StatusEffectKind::CONFUSION))
         {
-            const auto moveDiff = convertDir9ToPos(inputDirection);
-            const auto candidatePlayerPos = _player.getBoardPos() + moveDiff;
+            moveDir = _randomDirection(_rng);
+            isRunning = false;
+        }
 
-            // if player can move to the input direction, move to there.
-            if (_canMoveTo(_player, candidatePlayerPos))
-            {
-                isPlayerAlive =
-                    isPlayerAlive && _player.actPlayer(mob::MonsterAction(inputDirection, ActionType::MOVE));
-                _miniMap.updateBgPos(_player);
-                _startBgScroll(inputDirection);
+        const auto moveDiff = convertDir9ToPos(moveDir);
+        const auto candidatePlayerPos = _player.getBoardPos() + moveDiff;
 
-                // the player can only pick up an item when they don't already have one.
-                if (!_itemUse.hasInventoryItem())
+        // if player can move to the input direction, move to there.
+        if (_canMoveTo(_player.getBoardPos(), candidatePlayerPos))
+        {
+            isPlayerAlive = _player.actPlayer(mob::MonsterAction(moveDir, ActionType::MOVE));
+            isTurnSpent = true;
+            if (isRunning)
+                _moveFrames = consts::ACTOR_RUN_FRAMES;
+            _miniMap.updateBgPos(_player);
+            _startBgScroll(moveDir);
+
+            // the player can only pick up an item when their bag is not full.
+            if (_itemOccupancy.has(_player.getBoardPos()))
+            {
+                auto prev = _items.before_begin();
+                auto cur = _items.begin();
+                while (cur != _items.end() && !_itemUse.isBagFull())
                 {
-                    auto it = _items.before_begin();
-                    auto cur = it;
-                    ++cur;
-                    while (cur != _items.end())
+                    // check if the player stepped on the cur item, and pick it up.
+                    if (_player.getBoardPos() == cur->getBoardPos())
                     {
-                        cur = it;
+                        _log.add(LogTextKind::ITEM_PICKED_UP, LogArg::itemName(cur->getItemInfo().kind));
+                        _miniMap.removeStamp(MiniMap::StampKind::ITEM, cur->getBoardPos(), _floor);
+                        _itemOccupancy.reset(cur->getBoardPos());
+                        _itemUse.addItem(cur->getRecord());
+
+                        // floor item sprite is destroyed here.
+                        cur = _items.erase_after(prev);
+                    }
+                    else
+                    {
+                        prev = cur;
                         ++cur;
-                        // check if the player stepped on the cur item, and pick it up.
-                        if (_player.getBoardPos() == cur->getBoardPos())
-                        {
-                            cur->moveSpriteToInventory();
-                            _itemUse.setInventoryItem(bn::move(*cur));
-
-                            _items.erase_after(it);
-                        }
-                        else
-                            ++it;
                     }
                 }
             }
-            // if not, just change the player's direction without moving.
+
+            if (isRunning)
+            {
+                // sides right after the first step are compared with the later steps.
+                if (_runDirection == Direction9::NONE)
+                    _runSides = _getRunSides(_player.getBoardPos(), moveDir);
+                _runDirection = _findNextRunDirection(moveDir);
+            }
             else
+                _runDirection = Direction9::NONE;
+        }
+        // if not, just change the player's direction without moving.
+        else
+        {
+            isPlayerAlive = _player.actPlayer(mob::MonsterAction(moveDir, ActionType::CHANGE_DIRECTION));
+            _runDirection = Direction9::NONE;
+        }
+        break;
+    }
+
+    // select the next item in the bag
+    case CommandType::SELECT_NEXT_ITEM:
+        _itemUse.selectNextItem();
+        break;
+
+    case CommandType::USE_ITEM:
+        if (_itemUse.hasSelectedItem())
+        {
+            const item::ItemInfo& itemInfo = _itemUse.getSelectedItemInfo();
+            if (itemInfo.canBeUsed)
             {
-                isPlayerAlive = isPlayerAlive &&
-                                _player.actPlayer(mob::MonsterAction(inputDirection, ActionType::CHANGE_DIRECTION));
+                _log.add(LogTextKind::ITEM_USED, LogArg::itemName(itemInfo.kind));
+                item::ability::use(itemInfo.kind, _player, _itemUse, *this, _rng);
+                isTurnSpent = true;
             }
         }
+        break;
+
+    case CommandType::TOSS_ITEM:
+        if (_itemUse.hasSelectedItem() && !_items.full())
+            isTurnSpent = _tossSelectedItem();
+        break;
+
+    // waiting is only for when the player can't act.
+    case CommandType::WAIT:
+        break;
+
+    default:
+        BN_ERROR("Invalid Command::Type(", (s32)command.type, ")");
+    }
+
+    if (isTurnSpent)
+        _progressMonsterTurns();
+
+    if (_runDirection != Direction9::NONE && _shouldStopRun())
+        _runDirection = Direction9::NONE;
+
+    return isPlayerAlive;
+}
+
+auto Dungeon::_findNextRunDirection(Direction9 runDir) -> Direction9
+{
+    const BoardPos& pos = _player.getBoardPos();
+    const bool isAheadWalkable = _floor.getFloorTypeOf(pos + convertDir9ToPos(runDir)) != DungeonFloor::Type::WALL;
+
+    // diagonal run goes straight, until it's blocked.
+    if (_isDiagonal(runDir))
+        return isAheadWalkable ? runDir : Direction9::NONE;
+
+    const u8 sides = _getRunSides(pos, runDir);
+
+    // corridor bends to the only walkable side.
+    if (_runSides == 0 && !isAheadWalkable && (sides == RUN_LEFT_SIDE || sides == RUN_RIGHT_SIDE))
+        return (sides == RUN_LEFT_SIDE) ? _turnLeft(runDir) : _turnRight(runDir);
+
+    // a side has opened or closed, which is a branch, or where a room begins or ends.
+    if (sides != _runSides || !isAheadWalkable)
+        return Direction9::NONE;
+
+    return runDir;
+}
+
+u8 Dungeon::_getRunSides(const BoardPos& pos, Direction9 runDir) const
+{
+    using FloorType = DungeonFloor::Type;
+
+    u8 sides = 0;
+    if (_floor.getFloorTypeOf(pos + convertDir9ToPos(_turnLeft(runDir))) != FloorType::WALL)
+        sides |= RUN_LEFT_SIDE;
+    if (_floor.getFloorTypeOf(pos + convertDir9ToPos(_turnRight(runDir))) != FloorType::WALL)
+        sides |= RUN_RIGHT_SIDE;
+    return sides;
+}
+
+bool Dungeon::_shouldStopRun() const
+{
+    const BoardPos& playerPos = _player.getBoardPos();
+
+    for (s8 y = -1; y <= 1; ++y)
+    {
+        for (s8 x = -1; x <= 1; ++x)
+        {
+            // items are never on walls, which include the outside of the floor.
+            const BoardPos pos = playerPos + BoardPos{x, y};
+            if (_floor.getFloorTypeOf(pos) != DungeonFloor::Type::WALL && _itemOccupancy.has(pos))
+                return true;
+        }
     }
 
-    // item use
-    if (bn::keypad::l_held() && bn::keypad::a_pressed())
+    constexpr s32 SCREEN_HALF_COLUMNS = bn::display::width() / 2 / MetaTile::SIZE_IN_PIXELS.width();
+    constexpr s32 SCREEN_HALF_ROWS = bn::display::height() / 2 / MetaTile::SIZE_IN_PIXELS.height();
+
+    for (const BoardPos& monsterPos : _monsters.getPositions())
     {
-        if (_itemUse.getInventoryItem().has_value())
+        const BoardPos diff = monsterPos - playerPos;
+        if (_abs(diff.x) <= SCREEN_HALF_COLUMNS && _abs(diff.y) <= SCREEN_HALF_ROWS)
+            return true;
+    }
+
+    return false;
+}
+
+void Dungeon::_progressMonsterTurns()
+{
+    // monsters which stepped on an item, which are applied at once after every monster moved.
+    bn::vector<item::ability::StepOnHit, mob::MonsterTable::MAX_COUNT> stepOnHits;
+
+    _player.updateHungerStatus();
+    _scheduler.setSpeed(TurnScheduler::PLAYER_ACTOR, _player.getSpeed());
+    _scheduler.reschedule(TurnScheduler::PLAYER_ACTOR);
+
+    for (u8 actor = _scheduler.popNext(); actor != TurnScheduler::PLAYER_ACTOR; actor = _scheduler.popNext())
+    {
+        using ActionType = mob::MonsterAction::Type;
+
+        const s32 index = _monsters.getIndexOfSlot(actor);
+        const BoardPos pos = _monsters.getPositions()[index];
+        const mob::MonsterInfo& info = mob::MonsterInfo::fromSpecies(_monsters.getSpecies()[index]);
+        const mob::ai::Senses senses{pos, _player.getBoardPos(), _monsters.getHps()[index], info.maxHp};
+
+        const mob::StatusEffects& statuses = _monsters.getStatuses()[index];
+        Direction9 moveDir = Direction9::NONE;
+        if (!statuses.isIncapacitated())
         {
-            item::Item& item = _itemUse.getInventoryItem().value();
-            const item::ItemInfo& itemInfo = item.getItemInfo();
-            if (itemInfo.canBeUsed)
-                itemInfo.ability.use(_player, _itemUse, *this, _rng);
+            moveDir = info.ai.think(_monsters.getAIStates()[index], senses, _rng);
+            if (moveDir != Direction9::NONE && statuses.has(mob::StatusEffectKind::CONFUSION))
+                moveDir = _randomDirection(_rng);
+        }
+
+        if (moveDir == Direction9::NONE)
+            _monsters.act(index, mob::MonsterAction(moveDir, ActionType::DO_NOTHING));
+        else if (_canMoveTo(pos, pos + convertDir9ToPos(moveDir)))
+        {
+            _monsters.act(index, mob::MonsterAction(moveDir, ActionType::MOVE));
+            const BoardPos& movedPos = _monsters.getPositions()[index];
+            _mobOccupancy.move(pos, movedPos);
+            _miniMap.moveStamp(MiniMap::StampKind::ENEMY, pos, movedPos, _floor);
+            if (const item::Item* steppedItem = _findItemAt(movedPos); steppedItem && !stepOnHits.full())
+                stepOnHits.push_back({steppedItem->getItemInfo().kind, (s8)index});
         }
+        else
+            _monsters.act(index, mob::MonsterAction(moveDir, ActionType::CHANGE_DIRECTION));
+
+        _scheduler.reschedule(actor);
     }
 
-    // item toss
-    if (bn::keypad::l_held() && bn::keypad::r_pressed())
+    // tick before the step on hits, so that the effects from them last for their full turns.
+    _player.getStatuses().tick();
+    mob::StatusEffects::tickAll(_monsters.getStatuses());
+
+    item::ability::stepOnAll(bn::span<const item::ability::StepOnHit>(stepOnHits.data(), stepOnHits.size()), _monsters,
+                             _itemUse, *this, _rng);
+}
+
+void Dungeon::_spawnMonster(mob::MonsterSpecies species, const BoardPos& pos)
+{
+    const auto handle = _monsters.add(species, pos, _player.getBoardPos(), _camera);
+    _monsters.getAnimation(_monsters.getIndex(handle)).setVisible(true);
+
+    _scheduler.add(handle.slot, mob::MonsterInfo::fromSpecies(species).speed);
+    _mobOccupancy.set(pos);
+    _miniMap.addStamp(MiniMap::StampKind::ENEMY, pos, _floor);
+}
+
+bool Dungeon::_tossSelectedItem()
+{
+    const item::ItemInfo& info = _itemUse.getSelectedItemInfo();
+
+    const Direction9 tossDir = (_player.getDirection() == Direction9::NONE) ? Direction9::DOWN : _player.getDirection();
+    const BoardPos from = _player.getBoardPos();
+    const BoardPos to = from + convertDir9ToPos(tossDir) * (s8)info.tossDistance;
+
+    // the item can't land on another item, so it lands on the last free position it flew over.
+    BoardPos flyPos = from;
+    bn::optional<BoardPos> landPos;
+    if (!_itemOccupancy.has(from))
+        landPos = from;
+    s32 tiles = 0;
+    s32 hitMonsterIndex = -1;
+    for (BoardRay ray(from, to); !ray.done();)
     {
-        BN_ERROR("TODO: Add item toss");
+        const BoardPos& nextPos = ray.next();
+        if (_isBlockedByWall(flyPos, nextPos))
+            break;
+
+        flyPos = nextPos;
+        ++tiles;
+        if (!_itemOccupancy.has(flyPos))
+            landPos = flyPos;
+        if (_mobOccupancy.has(flyPos))
+        {
+            hitMonsterIndex = _monsters.findIndexAt(flyPos);
+            break;
+        }
     }
 
-    return isPlayerAlive;
+    if (!landPos)
+        return false;
+
+    const item::ItemRecord tossed = _itemUse.releaseSelectedItem();
+    _log.add(LogTextKind::ITEM_TOSSED, LogArg::itemName(info.kind));
+
+    // floor item sprite is created here.
+    _items.emplace_front(tossed, *landPos, _player, _camera);
+    const item::Item& landed = _items.front();
+    _itemOccupancy.set(*landPos);
+    _miniMap.addStamp(MiniMap::StampKind::ITEM, *landPos, _floor);
+
+    if (tiles > 0)
+        _itemUse.startTossAnimation(landed, _camera, tiles);
+
+    if (hitMonsterIndex >= 0)
+        item::ability::stepOn(info.kind, _monsters, hitMonsterIndex, _itemUse, *this, _rng);
+
+    return true;
+}
+
+auto Dungeon::_findItemAt(const BoardPos& pos) const -> const item::Item*
+{
+    if (!_itemOccupancy.has(pos))
+        return nullptr;
+
+    for (const item::Item& item : _items)
+        if (item.getBoardPos() == pos)
+            return &item;
+
+    return nullptr;
 }
 
 void Dungeon::_startBgScroll(Direction9 moveDir)
@@ -178,40 +581,56 @@ void Dungeon::_startBgScroll(Direction9 moveDir)
     bn::fixed_point destination = _camera.position();
     destination += {moveDiff.x * MetaTile::SIZE_IN_PIXELS.width(), moveDiff.y * MetaTile::SIZE_IN_PIXELS.height()};
 
-    _bg.startBgScroll(moveDir);
+    _bg.startBgScroll(moveDir, _moveFrames);
 
-    _camMoveAction = bn::camera_move_to_action(_camera, consts::ACTOR_MOVE_FRAMES, destination);
+    _camMoveAction = bn::camera_move_to_action(_camera, _moveFrames, destination);
 }
 
 bool Dungeon::_updateBgScroll()
 {
     BN_ASSERT(_camMoveAction);
+
+    // reset on the frame it's done, so that the next turn can start on the very next frame.
+    _camMoveAction->update();
     if (_camMoveAction->done())
     {
         _camMoveAction.reset();
         return true;
     }
-    _camMoveAction->update();
     return false;
 }
 
-bool Dungeon::_canMoveTo(const mob::Monster& mob, const BoardPos& destination) const
+void Dungeon::_setMapViewOpened(bool isOpened)
 {
-    using FloorType = DungeonFloor::Type;
-    if (_floor.getFloorTypeOf(destination) == FloorType::WALL)
-        return false;
-    // check diagonal adjacent wall
-    if (_floor.getFloorTypeOf(destination.x, mob.getBoardPos().y) == FloorType::WALL ||
-        _floor.getFloorTypeOf(mob.getBoardPos().x, destination.y) == FloorType::WALL)
+    // mini-map is an affine BG, which leaves only 2 regular BGs available.
+    _miniMap.setVisible(isOpened);
+    _log.setVisible(!isOpened);
+}
+
+bool Dungeon::_canMoveTo(const BoardPos& from, const BoardPos& destination) const
+{
+    if (_isBlockedByWall(from, destination))
         return false;
 
     // collide with player
     if (destination == _player.getBoardPos())
         return false;
 
-    // TODO: Add collide with _monsters
+    // collide with monsters
+    if (_mobOccupancy.has(destination))
+        return false;
 
     return true;
 }
 
+bool Dungeon::_isBlockedByWall(const BoardPos& from, const BoardPos& destination) const
+{
+    using FloorType = DungeonFloor::Type;
+    if (_floor.getFloorTypeOf(destination) == FloorType::WALL)
+        return true;
+    // check diagonal adjacent wall
+    return _floor.getFloorTypeOf(destination.x, from.y) == FloorType::WALL ||
+           _floor.getFloorTypeOf(from.x, destination.y) == FloorType::WALL;
+}
+
 } // namespace mp::game
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/DungeonBg.hpp"
+
+#include "bn_assert.h"
+
+#include "game/DungeonFloor.hpp"
+#include "game/LightingPalette.hpp"
+#include "game/ShadowTileset.hpp"
+
+// Per-cell redraws are the hot loops of the dungeon BG, both on the full redraw and on the scroll,
+// so they run from IWRAM as ARM code.
+
+namespace mp::game
+{
+
+template <bool UseVariants>
+void DungeonBg::_redrawCells(const DungeonFloor& dungeonFloor, const BoardPos& playerBoardPos,
+                             const bn::point& topLeftCell, const bn::point& bottomRightCell)
+{
+    using Neighbor3x3 = DungeonFloor::Neighbor3x3;
+    using NeighborBrightness3x3 = DungeonFloor::NeighborBrightness3x3;
+    using NeighborDiscover3x3 = DungeonFloor::NeighborDiscover3x3;
+
+    bn::regular_bg_map_cell* dunCells = _dunCells[_backCellBufferIdx];
+#ifndef MP_PALETTE_LIGHTING
+    bn::regular_bg_map_cell* shadowCells = _shadowCells[_backCellBufferIdx];
+#endif
+
+    s32 updatedTileCount = 0;
+    // from left-top to bottom-right tiles on screen
+    for (s32 y = topLeftCell.y();; y = (y + 1) % ROWS)
+    {
+        for (s32 x = topLeftCell.x();; x = (x + 1) % COLUMNS)
+        {
+            // find the current board pos of this cell's meta-tile.
+            const BoardPos metaTilePos = playerBoardPos + BoardPos{(s8)(-8 + (updatedTileCount % COLUMNS + 1) / 2),
+                                                                   (s8)(-5 + updatedTileCount / (COLUMNS * 2))};
+            // get the neighbors of the meta-tile
+            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos.x, metaTilePos.y);
+            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos.x, metaTilePos.y);
+            const s32 variant =
+                UseVariants ? (s32)(dungeonFloor.getCellHash(metaTilePos.x, metaTilePos.y) & VARIANT_MASK) : 0;
+            // get the right tile within the meta-tile, and assign it to current cell.
+            const s32 bgTileX = (updatedTileCount % 2 == 0 ? 1 : 0);
+            const s32 bgTileY = updatedTileCount / COLUMNS % 2;
+            const bn::regular_bg_map_cell dunCell = _getDunCell(neighbors, discovers, variant, bgTileX, bgTileY);
+
+            const NeighborBrightness3x3 brightnesses =
+                dungeonFloor.getNeighborBrightnessOf(metaTilePos.x, metaTilePos.y);
+#ifdef MP_PALETTE_LIGHTING
+            // bake the light level into the palette bank.
+            dunCells[_dunMapItem.cell_index(x, y)] = LightingPalette::getLitCell(dunCell, brightnesses);
+#else
+            dunCells[_dunMapItem.cell_index(x, y)] = dunCell;
+
+            // do the same thing with shadow area.
+            shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
+#endif
+
+            ++updatedTileCount;
+            if (x == bottomRightCell.x())
+                break;
+        }
+        if (y == bottomRightCell.y())
+            break;
+    }
+    BN_ASSERT(updatedTileCount == 22 * COLUMNS, "updatedTileCount is ", updatedTileCount, ", instead of ",
+              22 * COLUMNS);
+}
+
+template void DungeonBg::_redrawCells<true>(const DungeonFloor&, const BoardPos&, const bn::point&, const bn::point&);
+#ifdef MP_DEBUG
+template void DungeonBg::_redrawCells<false>(const DungeonFloor&, const BoardPos&, const bn::point&, const bn::point&);
+#endif
+
+void DungeonBg::_redrawScrolledColumn(const DungeonFloor& dungeonFloor, const BoardPos& playerBoardPos,
+                                      const bn::point& startCell, s32 endCellY, const bn::point& pixelDiff)
+{
+    s32 diffY = pixelDiff.y();
+
+    s32 updatedTileCount = 0;
+    for (s32 y = startCell.y();; y = (y + 1) % ROWS, diffY += 8)
+    {
+        _redrawCell({startCell.x(), y}, {pixelDiff.x(), diffY}, dungeonFloor, playerBoardPos);
+
+        ++updatedTileCount;
+        if (y == endCellY)
+            break;
+    }
+    BN_ASSERT(updatedTileCount == 22, "updatedTileCount is ", updatedTileCount, ", instead of 22");
+}
+
+void DungeonBg::_redrawScrolledRow(const DungeonFloor& dungeonFloor, const BoardPos& playerBoardPos,
+                                   const bn::point& startCell, s32 endCellX, const bn::point& pixelDiff,
+                                   s32 skippedCellX)
+{
+    s32 diffX = pixelDiff.x();
+
+    s32 updatedTileCount = 0;
+    for (s32 x = startCell.x();; x = (x + 1) % COLUMNS, diffX += 8)
+    {
+        if (x != skippedCellX)
+            _redrawCell({x, startCell.y()}, {diffX, pixelDiff.y()}, dungeonFloor, playerBoardPos);
+
+        ++updatedTileCount;
+        if (x == endCellX)
+            break;
+    }
+    BN_ASSERT(updatedTileCount == 32, "updatedTileCount is ", updatedTileCount, ", instead of 32");
+}
+
+void DungeonBg::_redrawCell(const bn::point& cellPos, const bn::point& pixelDiff, const DungeonFloor& dungeonFloor,
+                            const BoardPos& playerBoardPos)
+{
+    // meta-tile is 16x16 pixels, and its cell is 8x8 pixels.
+    const s32 metaTileX = playerBoardPos.x + (pixelDiff.x() >> 4);
+    const s32 metaTileY = playerBoardPos.y + (pixelDiff.y() >> 4);
+    const s32 bgTileX = (pixelDiff.x() >> 3) & 1;
+    const s32 bgTileY = (pixelDiff.y() >> 3) & 1;
+
+    const DungeonFloor::Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTileX, metaTileY);
+    const DungeonFloor::NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTileX, metaTileY);
+    const s32 variant = (s32)(dungeonFloor.getCellHash(metaTileX, metaTileY) & VARIANT_MASK);
+    const DungeonFloor::NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTileX, metaTileY);
+    const bn::regular_bg_map_cell dunCell = _getDunCell(neighbors, discovers, variant, bgTileX, bgTileY);
+    const s32 cellIdx = _dunMapItem.cell_index(cellPos);
+#ifdef MP_PALETTE_LIGHTING
+    _dunCells[_backCellBufferIdx][cellIdx] = LightingPalette::getLitCell(dunCell, brightnesses);
+#else
+    _dunCells[_backCellBufferIdx][cellIdx] = dunCell;
+    _shadowCells[_backCellBufferIdx][cellIdx] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
+#endif
+
+    if (!_allCellsDirty)
+        _dirtyCellIndexes.push_back((u16)cellIdx);
+}
+
+auto DungeonBg::_getDunCell(const DungeonFloor::Neighbor3x3& neighbors,
+                            const DungeonFloor::NeighborDiscover3x3& discovers, s32 variant, s32 bgTileX,
+                            s32 bgTileY) const -> bn::regular_bg_map_cell
+{
+    BN_ASSERT(0 <= bgTileX && bgTileX < MetaTile::COLUMNS, "MetaTile tileX(", bgTileX, ") OOB");
+    BN_ASSERT(0 <= bgTileY && bgTileY < MetaTile::ROWS, "MetaTile tileY(", bgTileY, ") OOB");
+
+    const s32 idx = MetaTileset::calcMetaTileIndex(neighbors, discovers);
+    const s32 variantIdx = idx * MetaTileset::VARIANTS_COUNT + variant;
+    return _metaTileCells[variantIdx * MetaTile::CELLS_COUNT + bgTileY * MetaTile::COLUMNS + bgTileX];
+}
+
+} // namespace mp::game
@@ -10,16 +10,26 @@
 
 #include "bn_algorithm.h"
 #include "bn_assert.h"
+#include "bn_bg_palette_item.h"
 #include "bn_blending.h"
 #include "bn_camera_ptr.h"
 #include "bn_display.h"
 #include "bn_fixed_rect.h"
 #include "bn_math.h"
+#include "bn_memory.h"
 #include "bn_point.h"
+#include "bn_profiler.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_tiles_item.h"
+#include "bn_tile.h"
 #include "bn_utility.h"
 
+#include "iso_bn_random.h"
+
+#include "Arena.hpp"
 #include "constants.hpp"
 #include "game/DungeonFloor.hpp"
+#include "game/LightingPalette.hpp"
 #include "game/MetaTileset.hpp"
 #include "game/ShadowTileset.hpp"
 #include "game/mob/Monster.hpp"
@@ -27,38 +37,83 @@
 namespace mp::game
 {
 
-namespace
-{
-constexpr bn::fixed_point BG_SIZE_HALF = {DungeonBg::COLUMNS * 8 / 2, DungeonBg::ROWS * 8 / 2};
-}
-
-// TODO: Pass MetaTilesetKind parameter, and init `_metaTileset` with it.
-DungeonBg::DungeonBg(const bn::camera_ptr& camera)
-    : _metaTileset(&MetaTileset::fromKind(MetaTilesetKind::PLACEHOLDER)),
-      _shadowTileset(ShadowTileset::get()), _dunCells{}, _shadowCells{},
+DungeonBg::DungeonBg(const bn::camera_ptr& camera, MetaTilesetKind metaTilesetKind, Arena& arena)
+    : _metaTileset(&MetaTileset::fromKind(metaTilesetKind)),
+#ifndef MP_PALETTE_LIGHTING
+      _shadowTileset(ShadowTileset::get()),
+#endif
+      _dunCells(arena.create<CellBuffers>().cells),
+#ifndef MP_PALETTE_LIGHTING
+      _shadowCells(arena.create<CellBuffers>().cells),
+#endif
       // dungeon bg init
-      _dunMapItem(_dunCells[0], bn::size(DungeonBg::COLUMNS, DungeonBg::ROWS)),
-      _dunBgItem(_metaTileset->getBgItem().tiles_item(), _metaTileset->getBgItem().palette_item(), _dunMapItem),
-      _dunBg(_dunBgItem.create_bg(0, 0)), _dunBgMap(_dunBg.map()),
+      _dunMapItem(_dunCells[0][0], bn::size(DungeonBg::COLUMNS, DungeonBg::ROWS), bn::compression_type::NONE,
+                  CELL_BUFFERS_COUNT),
+      _dunTiles(bn::regular_bg_tiles_ptr::allocate(DUN_TILES_COUNT, bn::bpp_mode::BPP_4)),
+      _dunPalette(_getDunPaletteItem(_metaTileset->getBgItem().palette_item()).create_palette()),
+      _dunBg(bn::regular_bg_ptr::create(0, 0, bn::regular_bg_map_ptr::create(_dunMapItem, _dunTiles, _dunPalette))),
+      _dunBgMap(_dunBg.map())
+#ifndef MP_PALETTE_LIGHTING
+      ,
       // shadow bg init
-      _shadowMapItem(_shadowCells[0], bn::size(DungeonBg::COLUMNS, DungeonBg::ROWS)),
+      _shadowMapItem(_shadowCells[0][0], bn::size(DungeonBg::COLUMNS, DungeonBg::ROWS), bn::compression_type::NONE,
+                     CELL_BUFFERS_COUNT),
       _shadowBgItem(_shadowTileset.getBgItem().tiles_item(), _shadowTileset.getBgItem().palette_item(), _shadowMapItem),
       _shadowBg(_shadowBgItem.create_bg(0, 0)), _shadowBgMap(_shadowBg.map())
+#endif
 {
     _initGraphics(camera);
+
+    // floor is not generated yet, so every meta-tile is uploaded.
+    MetaTileset::MetaTileFlags allMetaTiles;
+    allMetaTiles.set();
+    _setMetaTileset(*_metaTileset, allMetaTiles);
 }
 
 void DungeonBg::update(const DungeonFloor& dungeonFloor, const mob::Monster& player)
 {
+    if (isMetaTilesetLoading())
+        _uploadPendingTiles();
+
     if (isBgScrollOngoing())
         _updateBgScroll(dungeonFloor, player);
 
-    if (_cellsReloadRequired)
+    if (_allCellsDirty || !_dirtyCellIndexes.empty())
+        _swapCellBuffers();
+}
+
+void DungeonBg::_swapCellBuffers()
+{
+    const s32 frontIdx = _backCellBufferIdx;
+    _backCellBufferIdx = (_backCellBufferIdx + 1) % CELL_BUFFERS_COUNT;
+
+    // the whole map is uploaded on the next VBlank, so the half-redrawn cells are never shown.
+    _dunBgMap.set_cells_ref(_dunMapItem, frontIdx);
+#ifndef MP_PALETTE_LIGHTING
+    _shadowBgMap.set_cells_ref(_shadowMapItem, frontIdx);
+#endif
+
+    // copy only the changed cells to the new back buffer, unless everything has been redrawn.
+    if (_allCellsDirty)
     {
-        _cellsReloadRequired = false;
-        _dunBgMap.reload_cells_ref();
-        _shadowBgMap.reload_cells_ref();
+        bn::memory::copy(_dunCells[frontIdx][0], CELLS_COUNT, _dunCells[_backCellBufferIdx][0]);
+#ifndef MP_PALETTE_LIGHTING
+        bn::memory::copy(_shadowCells[frontIdx][0], CELLS_COUNT, _shadowCells[_backCellBufferIdx][0]);
+#endif
+    }
+    else
+    {
+        for (const u16 cellIdx : _dirtyCellIndexes)
+        {
+            _dunCells[_backCellBufferIdx][cellIdx] = _dunCells[frontIdx][cellIdx];
+#ifndef MP_PALETTE_LIGHTING
+            _shadowCells[_backCellBufferIdx][cellIdx] = _shadowCells[frontIdx][cellIdx];
+#endif
+        }
     }
+
+    _dirtyCellIndexes.clear();
+    _allCellsDirty = false;
 }
 
 bool DungeonBg::isBgScrollOngoing() const
@@ -66,36 +121,140 @@ bool DungeonBg::isBgScrollOngoing() const
     return _bgScrollCountdown > 0;
 }
 
-void DungeonBg::startBgScroll(Direction9 dir9)
+void DungeonBg::startBgScroll(Direction9 dir9, s32 moveFrames)
 {
-    _bgScrollCountdown = consts::ACTOR_MOVE_FRAMES;
+    BN_ASSERT(moveFrames > 0, "Invalid moveFrames(", moveFrames, ")");
+
+    _bgScrollCountdown = moveFrames;
+    _bgScrollFrames = moveFrames;
     _bgScrollDirection = dir9;
+    _bgScrollStartCamPos = _getCamera().position();
+
+    // camera will be on the center of the player's meta-tile after the scroll.
+    const BoardPos moveDiff = convertDir9ToPos(dir9);
+    const bn::fixed_point& camPos = _getCamera().position();
+    _bgScrollOrigin = {camPos.x().floor_integer() + moveDiff.x * MetaTile::SIZE_IN_PIXELS.width() -
+                           MetaTile::SIZE_IN_PIXELS.width() / 2,
+                       camPos.y().floor_integer() + moveDiff.y * MetaTile::SIZE_IN_PIXELS.height() -
+                           MetaTile::SIZE_IN_PIXELS.height() / 2};
 }
 
 void DungeonBg::_updateBgScroll(const DungeonFloor& dungeonFloor, const mob::Monster& player)
 {
-    switch (--_bgScrollCountdown)
-    {
-    case consts::ACTOR_MOVE_FRAMES - 1:
-        _redrawScrolledCells(0, dungeonFloor, player);
-        break;
-    case consts::ACTOR_MOVE_FRAMES - 5:
-        _redrawScrolledCells(1, dungeonFloor, player);
-        break;
-    default:
-        break;
-    }
+    --_bgScrollCountdown;
+
+    // first half on the first frame, and second half on the middle frame. (frames 7 & 3 of the 8 frames scroll)
+    // both are redrawn on the same frame, if the scroll takes only a frame.
+    if (_bgScrollCountdown == _bgScrollFrames - 1)
+        _redrawScrolledCells<true>(dungeonFloor, player, 0);
+    if (_bgScrollCountdown == bn::max(_bgScrollFrames / 2 - 1, 0))
+        _redrawScrolledCells<true>(dungeonFloor, player, 1);
 }
 
 bool DungeonBg::isVisible() const
 {
-    return _dunBg.visible();
+    return _isVisible;
 }
 
 void DungeonBg::setVisible(bool isVisible)
 {
-    _dunBg.set_visible(isVisible);
-    _shadowBg.set_visible(isVisible);
+    _isVisible = isVisible;
+
+    // keep it hidden while the meta-tileset is loading, and show it after the load.
+    const bool showBg = isVisible && !isMetaTilesetLoading();
+    _dunBg.set_visible(showBg);
+#ifndef MP_PALETTE_LIGHTING
+    _shadowBg.set_visible(showBg);
+#endif
+}
+
+void DungeonBg::setMetaTileset(const MetaTileset& metaTileset, const DungeonFloor& dungeonFloor)
+{
+    _setMetaTileset(metaTileset, metaTileset.calcUsedMetaTiles(dungeonFloor));
+}
+
+bool DungeonBg::isMetaTilesetLoading() const
+{
+    return !_pendingTileUploads.empty();
+}
+
+void DungeonBg::_setMetaTileset(const MetaTileset& metaTileset, const MetaTileset::MetaTileFlags& usedMetaTiles)
+{
+    BN_ASSERT(usedMetaTiles[0], "Invalid 'X' meta-tile should always be used");
+
+    _metaTileset = &metaTileset;
+    _pendingTileUploads.clear();
+
+    // pack the tiles of the used meta-tiles from the start of the VRAM tiles, and remap the cells to them.
+    bn::array<bn::regular_bg_map_cell, DUN_TILES_COUNT> remappedCells;
+    for (s32 idx = 0; idx < MetaTile::TILES_COUNT; ++idx)
+    {
+        if (!usedMetaTiles[idx])
+            continue;
+
+        const MetaTile& metaTile = metaTileset.getMetaTile((MetaTile::TileIndex)idx);
+        for (s32 cellIdx = 0; cellIdx < MetaTile::CELLS_COUNT; ++cellIdx)
+        {
+            bn::regular_bg_map_cell_info cellInfo(metaTile.cells[cellIdx]);
+            const s32 srcTileIndex = cellInfo.tile_index();
+
+            auto upload = bn::find_if(_pendingTileUploads.begin(), _pendingTileUploads.end(),
+                                      [srcTileIndex](const TileUpload& u) { return u.srcTileIndex == srcTileIndex; });
+            if (upload == _pendingTileUploads.end())
+            {
+                _pendingTileUploads.push_back(TileUpload{(u16)srcTileIndex, (u16)_pendingTileUploads.size()});
+                upload = _pendingTileUploads.end() - 1;
+            }
+
+            cellInfo.set_tile_index(upload->vramTileIndex);
+            remappedCells[idx * MetaTile::CELLS_COUNT + cellIdx] = cellInfo.cell();
+        }
+    }
+
+    // fold the variations into the cells table, so that the redraw doesn't need any branch to pick them.
+    // unused meta-tiles show the invalid 'X' tile.
+    for (s32 idx = 0; idx < MetaTile::TILES_COUNT; ++idx)
+    {
+        for (s32 variant = 0; variant < MetaTileset::VARIANTS_COUNT; ++variant)
+        {
+            const s32 variantIdx = metaTileset.getVariant((MetaTile::TileIndex)idx, variant);
+            const s32 srcIdx = usedMetaTiles[variantIdx] ? variantIdx : 0;
+            for (s32 cellIdx = 0; cellIdx < MetaTile::CELLS_COUNT; ++cellIdx)
+                _metaTileCells[(idx * MetaTileset::VARIANTS_COUNT + variant) * MetaTile::CELLS_COUNT + cellIdx] =
+                    remappedCells[srcIdx * MetaTile::CELLS_COUNT + cellIdx];
+        }
+    }
+
+    _dunPalette.set_colors(_getDunPaletteItem(metaTileset.getBgItem().palette_item()));
+
+    setVisible(_isVisible);
+}
+
+auto DungeonBg::_getDunPaletteItem(const bn::bg_palette_item& metaTilesetPalette) -> bn::bg_palette_item
+{
+#ifdef MP_PALETTE_LIGHTING
+    LightingPalette::buildColors(metaTilesetPalette, _dunColors);
+    return bn::bg_palette_item(_dunColors, bn::bpp_mode::BPP_4);
+#else
+    return metaTilesetPalette;
+#endif
+}
+
+void DungeonBg::_uploadPendingTiles()
+{
+    const auto& srcTiles = _metaTileset->getBgItem().tiles_item().tiles_ref();
+    bn::span<bn::tile> vram = *_dunTiles.vram();
+
+    for (s32 i = 0; i < DUN_TILES_UPLOAD_PER_FRAME && !_pendingTileUploads.empty(); ++i)
+    {
+        const TileUpload& upload = _pendingTileUploads.back();
+        vram[upload.vramTileIndex] = srcTiles[upload.srcTileIndex];
+        _pendingTileUploads.pop_back();
+    }
+
+    // show the BG after the load.
+    if (!isMetaTilesetLoading())
+        setVisible(_isVisible);
 }
 
 void DungeonBg::_initGraphics(const bn::camera_ptr& camera)
@@ -103,16 +262,18 @@ void DungeonBg::_initGraphics(const bn::camera_ptr& camera)
     setVisible(false);
 
     _dunBg.set_priority(consts::DUNGEON_BG_PRIORITY);
-    _shadowBg.set_priority(consts::DUNGEON_BG_PRIORITY);
-
     _dunBg.set_z_order(consts::DUNGEON_BG_Z_ORDER_WALLS);
+    _dunBg.set_camera(camera);
+
+#ifndef MP_PALETTE_LIGHTING
+    _shadowBg.set_priority(consts::DUNGEON_BG_PRIORITY);
     _shadowBg.set_z_order(consts::DUNGEON_BG_Z_ORDER_SHADOWS);
 
     _shadowBg.set_blending_enabled(true);
     bn::blending::set_transparency_alpha(0.5);
 
-    _dunBg.set_camera(camera);
     _shadowBg.set_camera(camera);
+#endif
 }
 
 const bn::camera_ptr& DungeonBg::_getCamera() const
@@ -130,31 +291,32 @@ static bn::fixed_rect _getCamRect(const bn::fixed_point& center)
 }
 
 /**
- * @brief Return two `bn::fixed_rect` that is moved to positive number range, while preserving relative position.
+ * @brief Map the camera position to the BG cell position, wrapping around the 256x256 BG.
+ * As the BG size is the power of 2, wrapping is done with the integer shifts and masks.
  */
-static auto _getMovedRectToPositive(bn::fixed_rect r1, bn::fixed_rect r2) -> bn::pair<bn::fixed_rect, bn::fixed_rect>
+static bn::point _camPosToCellPos(const bn::fixed_point& camPos)
 {
-    while (r1.left() < 0 || r2.left() < 0)
-    {
-        const s32 diff = (bn::max(bn::abs(r1.left()), bn::abs(r2.left())) / (DungeonBg::COLUMNS * 8)).ceil_integer() *
-                         (DungeonBg::COLUMNS * 8);
-        r1.set_x(r1.x() + diff);
-        r2.set_x(r2.x() + diff);
-    }
-    while (r1.top() < 0 || r2.top() < 0)
-    {
-        const s32 diff = (bn::max(bn::abs(r1.top()), bn::abs(r2.top())) / (DungeonBg::ROWS * 8)).ceil_integer() *
-                         (DungeonBg::ROWS * 8);
-        r1.set_y(r1.y() + diff);
-        r2.set_y(r2.y() + diff);
-    }
-    return {r1, r2};
+    static_assert((DungeonBg::COLUMNS & (DungeonBg::COLUMNS - 1)) == 0);
+    static_assert((DungeonBg::ROWS & (DungeonBg::ROWS - 1)) == 0);
+
+    // `floor_integer()` is an arithmetic shift, which floors the negative numbers as well.
+    const s32 x = ((camPos.x().floor_integer() + DungeonBg::COLUMNS * 8 / 2) >> 3) & (DungeonBg::COLUMNS - 1);
+    const s32 y = ((camPos.y().floor_integer() + DungeonBg::ROWS * 8 / 2) >> 3) & (DungeonBg::ROWS - 1);
+    return {x, y};
+}
+
+#ifdef MP_DEBUG
+// previous `bn::fixed` wrapping functions, which are kept to test the cell mapper against.
+
+namespace
+{
+constexpr bn::fixed_point BG_SIZE_HALF = {DungeonBg::COLUMNS * 8 / 2, DungeonBg::ROWS * 8 / 2};
 }
 
 /**
  * @brief Clamp `bn::fixed_point` to the range [0..256)
  */
-static bn::fixed_point _clampedPosToBg(bn::fixed_point point)
+static bn::fixed_point _oldClampedPosToBg(bn::fixed_point point)
 {
     while (point.x() < 0)
     {
@@ -181,7 +343,7 @@ static bn::fixed_point _clampedPosToBg(bn::fixed_point point)
     return point;
 }
 
-static bn::point _convertPosToCellPos(const bn::fixed_point& point)
+static bn::point _oldConvertPosToCellPos(const bn::fixed_point& point)
 {
     BN_ASSERT(0 <= point.x() && point.x() < DungeonBg::COLUMNS * 8, "point.x(): ", point.x(), ", OOB");
     BN_ASSERT(0 <= point.y() && point.y() < DungeonBg::ROWS * 8, "point.y(): ", point.y(), ", OOB");
@@ -193,175 +355,232 @@ static bn::point _convertPosToCellPos(const bn::fixed_point& point)
     return result;
 }
 
-void DungeonBg::redrawAll(const DungeonFloor& dungeonFloor, const mob::Monster& player)
+void DungeonBg::testCellMapper(iso_bn::random& rng)
 {
-    using Neighbor3x3 = DungeonFloor::Neighbor3x3;
-    using NeighborBrightness3x3 = DungeonFloor::NeighborBrightness3x3;
-    using NeighborDiscover3x3 = DungeonFloor::NeighborDiscover3x3;
-
-    _cellsReloadRequired = true;
+    constexpr s32 TEST_COUNT = 1024;
+    // a few BG sizes far, both positive and negative
+    constexpr s32 TEST_RANGE = 4 * DungeonBg::COLUMNS * 8;
 
-    auto camRect = _getCamRect(_getCamera().position());
-    const BoardPos& playerBoardPos = player.getBoardPos();
-
-    auto topLeftCell = _convertPosToCellPos(_clampedPosToBg(camRect.top_left() + BG_SIZE_HALF));
-    auto bottomRightCell = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_right() + BG_SIZE_HALF));
+    for (s32 i = 0; i < TEST_COUNT; ++i)
+    {
+        // random fractional part included
+        const bn::fixed_point camPos(bn::fixed::from_data(rng.get_int(-TEST_RANGE << 12, TEST_RANGE << 12)),
+                                     bn::fixed::from_data(rng.get_int(-TEST_RANGE << 12, TEST_RANGE << 12)));
+
+        const bn::point expected = _oldConvertPosToCellPos(_oldClampedPosToBg(camPos + BG_SIZE_HALF));
+        const bn::point actual = _camPosToCellPos(camPos);
+        BN_ASSERT(expected == actual, "Cell mapper mismatch on (", camPos.x(), ", ", camPos.y(), "): expected (",
+                  expected.x(), ", ", expected.y(), "), actual (", actual.x(), ", ", actual.y(), ")");
+    }
 
-    s32 updatedTileCount = 0;
-    // from left-top to bottom-right tiles on screen
-    for (s32 y = topLeftCell.y();; y = (y + 1) % ROWS)
+    // boundaries of the BG wrapping
+    for (s32 pixel = -TEST_RANGE; pixel <= TEST_RANGE; pixel += 8)
     {
-        for (s32 x = topLeftCell.x();; x = (x + 1) % COLUMNS)
+        for (const bn::fixed delta : {bn::fixed(-0.5), bn::fixed(0), bn::fixed(0.5)})
         {
-            // find the current board pos of this cell's meta-tile.
-            const BoardPos metaTilePos = playerBoardPos + BoardPos{(s8)(-8 + (updatedTileCount % COLUMNS + 1) / 2),
-                                                                   (s8)(-5 + updatedTileCount / (COLUMNS * 2))};
-            // get the neighbors of the meta-tile
-            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos);
-            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos);
-            // get the right tile within the meta-tile, and assign it to current cell.
-            const s32 bgTileX = (updatedTileCount % 2 == 0 ? 1 : 0);
-            const s32 bgTileY = updatedTileCount / COLUMNS % 2;
-            _dunCells[_dunMapItem.cell_index(x, y)] = _metaTileset->getCell(neighbors, discovers, bgTileX, bgTileY);
-
-            // do the same thing with shadow area.
-            const NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTilePos);
-            _shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
-
-            ++updatedTileCount;
-            if (x == bottomRightCell.x())
-                break;
+            const bn::fixed_point camPos(pixel + delta, -pixel + delta);
+            BN_ASSERT(_oldConvertPosToCellPos(_oldClampedPosToBg(camPos + BG_SIZE_HALF)) == _camPosToCellPos(camPos),
+                      "Cell mapper mismatch on (", camPos.x(), ", ", camPos.y(), ")");
         }
-        if (y == bottomRightCell.y())
-            break;
     }
-    BN_ASSERT(updatedTileCount == 22 * COLUMNS, "updatedTileCount is ", updatedTileCount, ", instead of ",
-              22 * COLUMNS);
 }
+#endif
 
-void DungeonBg::_redrawScrolledCells(s32 scrollPhase, const DungeonFloor& dungeonFloor, const mob::Monster& player)
+void DungeonBg::redrawAll(const DungeonFloor& dungeonFloor, const mob::Monster& player)
 {
-    BN_ASSERT(0 <= scrollPhase && scrollPhase < 2, "Invalid scrollPhase(", scrollPhase, ")");
-    _cellsReloadRequired = true;
+    BN_PROFILER_START("dungeon_bg_redraw_all");
+    _redrawAllCells<true>(dungeonFloor, player);
+    BN_PROFILER_STOP();
+}
+
+template <bool UseVariants>
+void DungeonBg::_redrawAllCells(const DungeonFloor& dungeonFloor, const mob::Monster& player)
+{
+    _allCellsDirty = true;
 
     auto camRect = _getCamRect(_getCamera().position());
-    const BoardPos& playerBoardPos = player.getBoardPos();
 
-    // TODO: Clean up messy & copy-pasta code
+    auto topLeftCell = _camPosToCellPos(camRect.top_left());
+    auto bottomRightCell = _camPosToCellPos(camRect.bottom_right());
+
+    _redrawCells<UseVariants>(dungeonFloor, player.getBoardPos(), topLeftCell, bottomRightCell);
+}
+
+#ifdef MP_DEBUG
+void DungeonBg::benchmarkVariants(const DungeonFloor& dungeonFloor, const mob::Monster& player)
+{
+    constexpr s32 BENCHMARK_COUNT = 16;
 
-    // update the camera boundary cells
-    switch (_bgScrollDirection)
+    // single-variant path: no cell hash is calculated, and the variation is always 0.
+    for (s32 i = 0; i < BENCHMARK_COUNT; ++i)
     {
-        using Dir9 = Direction9;
-        using Neighbor3x3 = DungeonFloor::Neighbor3x3;
-        using NeighborBrightness3x3 = DungeonFloor::NeighborBrightness3x3;
-        using NeighborDiscover3x3 = DungeonFloor::NeighborDiscover3x3;
-    // update the right column
-    case Dir9::RIGHT: {
-        const s32 x = _convertPosToCellPos(_clampedPosToBg(camRect.top_right() + BG_SIZE_HALF)).x();
-        const s32 startCellY = _convertPosToCellPos(_clampedPosToBg(camRect.top_right() + BG_SIZE_HALF)).y();
-        const s32 endCellY = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_right() + BG_SIZE_HALF)).y();
-        s32 updatedTileCount = 0;
-        for (s32 y = startCellY;; y = (y + 1) % ROWS)
-        {
-            const BoardPos metaTilePos =
-                playerBoardPos + BoardPos{(s8)(scrollPhase == 1 ? 8 : 7), (s8)(-5 + updatedTileCount / 2)};
-            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos);
-            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos);
-            const s32 bgTileX = (scrollPhase == 0 ? 1 : 0);
-            const s32 bgTileY = updatedTileCount % 2;
-            _dunCells[_dunMapItem.cell_index(x, y)] = _metaTileset->getCell(neighbors, discovers, bgTileX, bgTileY);
-
-            const NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTilePos);
-            _shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
-
-            ++updatedTileCount;
-            if (y == endCellY)
-                break;
-        }
-        BN_ASSERT(updatedTileCount == 22, "updatedTileCount is ", updatedTileCount, ", instead of 22");
+        BN_PROFILER_START("dungeon_bg_single_variant");
+        _redrawAllCells<false>(dungeonFloor, player);
+        BN_PROFILER_STOP();
     }
-    break;
-    // update the left column
-    case Dir9::LEFT: {
-        const s32 x = _convertPosToCellPos(_clampedPosToBg(camRect.top_left() + BG_SIZE_HALF)).x();
-        const s32 startCellY = _convertPosToCellPos(_clampedPosToBg(camRect.top_left() + BG_SIZE_HALF)).y();
-        const s32 endCellY = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_left() + BG_SIZE_HALF)).y();
-        s32 updatedTileCount = 0;
-        for (s32 y = startCellY;; y = (y + 1) % ROWS)
-        {
-            const BoardPos metaTilePos =
-                playerBoardPos + BoardPos{(s8)(scrollPhase == 1 ? -8 : -7), (s8)(-5 + updatedTileCount / 2)};
-            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos);
-            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos);
-            const s32 bgTileX = (scrollPhase == 0 ? 0 : 1);
-            const s32 bgTileY = updatedTileCount % 2;
-            _dunCells[_dunMapItem.cell_index(x, y)] = _metaTileset->getCell(neighbors, discovers, bgTileX, bgTileY);
-
-            const NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTilePos);
-            _shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
-
-            ++updatedTileCount;
-            if (y == endCellY)
-                break;
-        }
-        BN_ASSERT(updatedTileCount == 22, "updatedTileCount is ", updatedTileCount, ", instead of 22");
+
+    // variations last, so that the BG is left with them.
+    for (s32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        BN_PROFILER_START("dungeon_bg_variants");
+        _redrawAllCells<true>(dungeonFloor, player);
+        BN_PROFILER_STOP();
     }
-    break;
-    // update the top row
-    case Dir9::UP: {
-        const s32 y = _convertPosToCellPos(_clampedPosToBg(camRect.top_left() + BG_SIZE_HALF)).y();
-        const s32 startCellX = _convertPosToCellPos(_clampedPosToBg(camRect.top_left() + BG_SIZE_HALF)).x();
-        const s32 endCellX = _convertPosToCellPos(_clampedPosToBg(camRect.top_right() + BG_SIZE_HALF)).x();
-        s32 updatedTileCount = 0;
-        for (s32 x = startCellX;; x = (x + 1) % COLUMNS)
-        {
-            const BoardPos metaTilePos = playerBoardPos + BoardPos{(s8)(-8 + (updatedTileCount + 1) / 2), -5};
-            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos);
-            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos);
-            const s32 bgTileX = (updatedTileCount + 1) % 2;
-            const s32 bgTileY = (scrollPhase == 0 ? 1 : 0);
-            _dunCells[_dunMapItem.cell_index(x, y)] = _metaTileset->getCell(neighbors, discovers, bgTileX, bgTileY);
-
-            const NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTilePos);
-            _shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
-
-            ++updatedTileCount;
-            if (x == endCellX)
-                break;
-        }
-        BN_ASSERT(updatedTileCount == 32, "updatedTileCount is ", updatedTileCount, ", instead of 32");
+}
+#endif
+
+template <bool InIwram>
+void DungeonBg::_redrawScrolledCells(const DungeonFloor& dungeonFloor, const mob::Monster& player, s32 half)
+{
+    const BoardPos& playerBoardPos = player.getBoardPos();
+    const BoardPos moveDiff = convertDir9ToPos(_bgScrollDirection);
+
+    BN_ASSERT(!(moveDiff == BoardPos{0, 0}), "Invalid scroll direction(", (s32)_bgScrollDirection, ")");
+    BN_ASSERT(half == 0 || half == 1, "Invalid half(", half, ")");
+
+    // where the camera is at the end of that half, which is on the 8 px grid on both axes.
+    // (a camera off the grid makes the rect span 23 rows & 33 columns on a diagonal scroll)
+    const s32 movedPixels = (half + 1) * MetaTile::SIZE_IN_PIXELS.width() / 2;
+    const bn::fixed_point camPos =
+        _bgScrollStartCamPos + bn::fixed_point(moveDiff.x * movedPixels, moveDiff.y * movedPixels);
+    BN_ASSERT(camPos == bn::fixed_point(camPos.x().floor_integer() & ~7, camPos.y().floor_integer() & ~7),
+              "Scroll camera(", camPos.x(), ", ", camPos.y(), ") is off the 8 px grid");
+    const auto camRect = _getCamRect(camPos);
+
+    // update the right or left column
+    s32 redrawnCellX = -1;
+    if (moveDiff.x != 0)
+    {
+        const bn::fixed_point top = (moveDiff.x > 0) ? camRect.top_right() : camRect.top_left();
+        const bn::fixed_point bottom = (moveDiff.x > 0) ? camRect.bottom_right() : camRect.bottom_left();
+        const bn::point startCell = _camPosToCellPos(top);
+        const s32 endCellY = _camPosToCellPos(bottom).y();
+
+        // pixel diff from the top-left of the player's meta-tile, aligned to the cell.
+        const bn::point pixelDiff((top.x().floor_integer() & ~7) - _bgScrollOrigin.x(),
+                                  (top.y().floor_integer() & ~7) - _bgScrollOrigin.y());
+
+        if constexpr (InIwram)
+            _redrawScrolledColumn(dungeonFloor, playerBoardPos, startCell, endCellY, pixelDiff);
+#ifdef MP_DEBUG
+        else
+            _romRedrawScrolledColumn(dungeonFloor, playerBoardPos, startCell, endCellY, pixelDiff);
+#endif
+
+        redrawnCellX = startCell.x();
+    }
+
+    // update the bottom or top row, except for the corner cell already redrawn with the column.
+    if (moveDiff.y != 0)
+    {
+        const bn::fixed_point left = (moveDiff.y > 0) ? camRect.bottom_left() : camRect.top_left();
+        const bn::fixed_point right = (moveDiff.y > 0) ? camRect.bottom_right() : camRect.top_right();
+        const bn::point startCell = _camPosToCellPos(left);
+        const s32 endCellX = _camPosToCellPos(right).x();
+
+        // pixel diff from the top-left of the player's meta-tile, aligned to the cell.
+        const bn::point pixelDiff((left.x().floor_integer() & ~7) - _bgScrollOrigin.x(),
+                                  (left.y().floor_integer() & ~7) - _bgScrollOrigin.y());
+
+        if constexpr (InIwram)
+            _redrawScrolledRow(dungeonFloor, playerBoardPos, startCell, endCellX, pixelDiff, redrawnCellX);
+#ifdef MP_DEBUG
+        else
+            _romRedrawScrolledRow(dungeonFloor, playerBoardPos, startCell, endCellX, pixelDiff, redrawnCellX);
+#endif
     }
-    break;
-    // update the bottom row
-    case Dir9::DOWN: {
-        const s32 y = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_left() + BG_SIZE_HALF)).y();
-        const s32 startCellX = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_left() + BG_SIZE_HALF)).x();
-        const s32 endCellX = _convertPosToCellPos(_clampedPosToBg(camRect.bottom_right() + BG_SIZE_HALF)).x();
-        s32 updatedTileCount = 0;
-        for (s32 x = startCellX;; x = (x + 1) % COLUMNS)
+}
+
+#ifdef MP_DEBUG
+void DungeonBg::benchmarkScrollRedraw(const DungeonFloor& dungeonFloor, const mob::Monster& player)
+{
+    // the scroll is only set up, and the camera stays, as the redraw only depends on the scroll start.
+    for (s32 dir = (s32)Direction9::UP; dir <= (s32)Direction9::UP_LEFT; ++dir)
+    {
+        startBgScroll((Direction9)dir, consts::ACTOR_MOVE_FRAMES);
+
+        for (s32 half = 0; half < 2; ++half)
         {
-            const BoardPos metaTilePos = playerBoardPos + BoardPos{(s8)(-8 + (updatedTileCount + 1) / 2), 5};
-            const Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTilePos);
-            const NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTilePos);
-            const s32 bgTileX = (updatedTileCount + 1) % 2;
-            const s32 bgTileY = (scrollPhase == 0 ? 0 : 1);
-            _dunCells[_dunMapItem.cell_index(x, y)] = _metaTileset->getCell(neighbors, discovers, bgTileX, bgTileY);
-
-            const NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTilePos);
-            _shadowCells[_shadowMapItem.cell_index(x, y)] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
-
-            ++updatedTileCount;
-            if (x == endCellX)
-                break;
+            _dirtyCellIndexes.clear();
+            BN_PROFILER_START("dungeon_bg_scroll_rom");
+            _redrawScrolledCells<false>(dungeonFloor, player, half);
+            BN_PROFILER_STOP();
+
+            _dirtyCellIndexes.clear();
+            BN_PROFILER_START("dungeon_bg_scroll_iwram");
+            _redrawScrolledCells<true>(dungeonFloor, player, half);
+            BN_PROFILER_STOP();
         }
-        BN_ASSERT(updatedTileCount == 32, "updatedTileCount is ", updatedTileCount, ", instead of 32");
     }
-    break;
 
-    default:
-        BN_ERROR("Invalid scroll direction(", (s32)_bgScrollDirection, ")");
+    // cancel the scroll, and restore the cells around the camera.
+    _bgScrollCountdown = 0;
+    _redrawAllCells<true>(dungeonFloor, player);
+}
+
+// ROM (Thumb) builds of the scroll redraw, which are the same as the ones in `DungeonBg.bn_iwram.cpp`.
+
+void DungeonBg::_romRedrawScrolledColumn(const DungeonFloor& dungeonFloor, const BoardPos& playerBoardPos,
+                                         const bn::point& startCell, s32 endCellY, const bn::point& pixelDiff)
+{
+    s32 diffY = pixelDiff.y();
+
+    s32 updatedTileCount = 0;
+    for (s32 y = startCell.y();; y = (y + 1) % ROWS, diffY += 8)
+    {
+        _romRedrawCell({startCell.x(), y}, {pixelDiff.x(), diffY}, dungeonFloor, playerBoardPos);
+
+        ++updatedTileCount;
+        if (y == endCellY)
+            break;
+    }
+    BN_ASSERT(updatedTileCount == 22, "updatedTileCount is ", updatedTileCount, ", instead of 22");
+}
+
+void DungeonBg::_romRedrawScrolledRow(const DungeonFloor& dungeonFloor, const BoardPos& playerBoardPos,
+                                      const bn::point& startCell, s32 endCellX, const bn::point& pixelDiff,
+                                      s32 skippedCellX)
+{
+    s32 diffX = pixelDiff.x();
+
+    s32 updatedTileCount = 0;
+    for (s32 x = startCell.x();; x = (x + 1) % COLUMNS, diffX += 8)
+    {
+        if (x != skippedCellX)
+            _romRedrawCell({x, startCell.y()}, {diffX, pixelDiff.y()}, dungeonFloor, playerBoardPos);
+
+        ++updatedTileCount;
+        if (x == endCellX)
+            break;
     }
+    BN_ASSERT(updatedTileCount == 32, "updatedTileCount is ", updatedTileCount, ", instead of 32");
+}
+
+void DungeonBg::_romRedrawCell(const bn::point& cellPos, const bn::point& pixelDiff, const DungeonFloor& dungeonFloor,
+                               const BoardPos& playerBoardPos)
+{
+    // meta-tile is 16x16 pixels, and its cell is 8x8 pixels.
+    const s32 metaTileX = playerBoardPos.x + (pixelDiff.x() >> 4);
+    const s32 metaTileY = playerBoardPos.y + (pixelDiff.y() >> 4);
+    const s32 bgTileX = (pixelDiff.x() >> 3) & 1;
+    const s32 bgTileY = (pixelDiff.y() >> 3) & 1;
+
+    const DungeonFloor::Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(metaTileX, metaTileY);
+    const DungeonFloor::NeighborDiscover3x3 discovers = dungeonFloor.getNeighborDiscoverOf(metaTileX, metaTileY);
+    const s32 variant = (s32)(dungeonFloor.getCellHash(metaTileX, metaTileY) & VARIANT_MASK);
+    const DungeonFloor::NeighborBrightness3x3 brightnesses = dungeonFloor.getNeighborBrightnessOf(metaTileX, metaTileY);
+    const bn::regular_bg_map_cell dunCell = _getDunCell(neighbors, discovers, variant, bgTileX, bgTileY);
+    const s32 cellIdx = _dunMapItem.cell_index(cellPos);
+#ifdef MP_PALETTE_LIGHTING
+    _dunCells[_backCellBufferIdx][cellIdx] = LightingPalette::getLitCell(dunCell, brightnesses);
+#else
+    _dunCells[_backCellBufferIdx][cellIdx] = dunCell;
+    _shadowCells[_backCellBufferIdx][cellIdx] = _shadowTileset.getCell(brightnesses, bgTileX, bgTileY);
+#endif
+
+    if (!_allCellsDirty)
+        _dirtyCellIndexes.push_back((u16)cellIdx);
 }
+#endif
 
 } // namespace mp::game
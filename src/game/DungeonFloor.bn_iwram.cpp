@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/DungeonFloor.hpp"
+
+// Neighbor gathers and cell hash are called for every redrawn cell, so they run from IWRAM as ARM code.
+// They access the boards directly, instead of calling the ROM getters for each neighbor.
+
+namespace mp::game
+{
+
+auto DungeonFloor::getNeighborsOf(s32 x, s32 y) const -> Neighbor3x3
+{
+    Neighbor3x3 result;
+    for (s32 iy = 0; iy < 3; ++iy)
+    {
+        const s32 py = y + iy - 1;
+        for (s32 ix = 0; ix < 3; ++ix)
+        {
+            const s32 px = x + ix - 1;
+            const bool isOOB = (u32)px >= (u32)COLUMNS || (u32)py >= (u32)ROWS;
+            result[iy][ix] = isOOB ? Type::WALL : _board[py][px];
+        }
+    }
+    return result;
+}
+
+auto DungeonFloor::getNeighborBrightnessOf(s32 x, s32 y) const -> NeighborBrightness3x3
+{
+    NeighborBrightness3x3 result;
+    for (s32 iy = 0; iy < 3; ++iy)
+    {
+        const s32 py = y + iy - 1;
+        for (s32 ix = 0; ix < 3; ++ix)
+        {
+            const s32 px = x + ix - 1;
+            const bool isOOB = (u32)px >= (u32)COLUMNS || (u32)py >= (u32)ROWS;
+            result[iy][ix] = isOOB ? (s8)0 : _brightnesses[py][px];
+        }
+    }
+    return result;
+}
+
+auto DungeonFloor::getNeighborDiscoverOf(s32 x, s32 y) const -> NeighborDiscover3x3
+{
+    NeighborDiscover3x3 result;
+    for (s32 iy = 0; iy < 3; ++iy)
+    {
+        const s32 py = y + iy - 1;
+        for (s32 ix = 0; ix < 3; ++ix)
+        {
+            const s32 px = x + ix - 1;
+            const bool isOOB = (u32)px >= (u32)COLUMNS || (u32)py >= (u32)ROWS;
+            result[iy][ix] = isOOB || _discoverBoard[py][px];
+        }
+    }
+    return result;
+}
+
+u32 DungeonFloor::getCellHash(s32 x, s32 y) const
+{
+    u32 hash = ((u32)x * 0x9E3779B1u) ^ ((u32)y * 0x85EBCA77u) ^ _seeds[0] ^ _seeds[1] ^ _seeds[2];
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    hash ^= hash >> 12;
+    return hash;
+}
+
+} // namespace mp::game
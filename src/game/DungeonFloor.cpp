@@ -12,6 +12,7 @@
 
 #include "iso_bn_random.h"
 
+#include "Arena.hpp"
 #include "game/DungeonGenerator.hpp"
 
 namespace mp::game
@@ -34,21 +35,6 @@ auto DungeonFloor::getFloorTypeOf(const BoardPos& pos) const -> Type
     return getFloorTypeOf(pos.x, pos.y);
 }
 
-auto DungeonFloor::getNeighborsOf(s32 x, s32 y) const -> Neighbor3x3
-{
-    Neighbor3x3 result;
-    for (s32 iy = 0; iy < 3; ++iy)
-    {
-        const s32 py = y + iy - 1;
-        for (s32 ix = 0; ix < 3; ++ix)
-        {
-            const s32 px = x + ix - 1;
-            result[iy][ix] = getFloorTypeOf(px, py);
-        }
-    }
-    return result;
-}
-
 auto DungeonFloor::getNeighborsOf(const BoardPos& pos) const -> Neighbor3x3
 {
     return getNeighborsOf(pos.x, pos.y);
@@ -67,21 +53,6 @@ s8 DungeonFloor::getBrightnessOf(const BoardPos& pos) const
     return getBrightnessOf(pos.x, pos.y);
 }
 
-auto DungeonFloor::getNeighborBrightnessOf(s32 x, s32 y) const -> NeighborBrightness3x3
-{
-    NeighborBrightness3x3 result;
-    for (s32 iy = 0; iy < 3; ++iy)
-    {
-        const s32 py = y + iy - 1;
-        for (s32 ix = 0; ix < 3; ++ix)
-        {
-            const s32 px = x + ix - 1;
-            result[iy][ix] = getBrightnessOf(px, py);
-        }
-    }
-    return result;
-}
-
 auto DungeonFloor::getNeighborBrightnessOf(const BoardPos& pos) const -> NeighborBrightness3x3
 {
     return getNeighborBrightnessOf(pos.x, pos.y);
@@ -100,41 +71,28 @@ bool DungeonFloor::getDiscoverOf(const BoardPos& pos) const
     return getDiscoverOf(pos.x, pos.y);
 }
 
-auto DungeonFloor::getNeighborDiscoverOf(s32 x, s32 y) const -> NeighborDiscover3x3
-{
-    NeighborDiscover3x3 result;
-    for (s32 iy = 0; iy < 3; ++iy)
-    {
-        const s32 py = y + iy - 1;
-        for (s32 ix = 0; ix < 3; ++ix)
-        {
-            const s32 px = x + ix - 1;
-            result[iy][ix] = getDiscoverOf(px, py);
-        }
-    }
-    return result;
-}
-
 auto DungeonFloor::getNeighborDiscoverOf(const BoardPos& pos) const -> NeighborDiscover3x3
 {
     return getNeighborDiscoverOf(pos.x, pos.y);
 }
 
-void DungeonFloor::generate(iso_bn::random& rng)
+void DungeonFloor::generate(iso_bn::random& rng, Arena& scratch)
 {
     // Save current seed to generate this floor identically for the loaded game.
     _seeds = {rng.seed_x(), rng.seed_y(), rng.seed_z()};
 
-    DungeonGenerator gen;
+    // generator is too big for the IWRAM stack.
+    Arena::Scope scratchScope(scratch);
+    DungeonGenerator& gen = scratch.create<DungeonGenerator>();
     gen.generate(_board, rng);
 }
 
-void DungeonFloor::generate(u32 seed_x, u32 seed_y, u32 seed_z)
+void DungeonFloor::generate(u32 seed_x, u32 seed_y, u32 seed_z, Arena& scratch)
 {
     iso_bn::random rng;
     rng.set_seed(seed_x, seed_y, seed_z);
 
-    generate(rng);
+    generate(rng, scratch);
 }
 
 } // namespace mp::game
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/DungeonGenerator.hpp"
+
+#include "bn_algorithm.h"
+#include "bn_deque.h"
+
+#include "utils.hpp"
+
+// Cellular automata smoothing and its BFS are the heaviest parts of the generation,
+// so they run from IWRAM as ARM code.
+
+namespace mp::game
+{
+
+using Gen = DungeonGenerator;
+
+void Gen::_smoothCellularRoom(const Room& prev, Room& cur)
+{
+    // clear `cur` with zero
+    for (auto& row : cur.floors)
+        for (auto& elem : row)
+            elem = (FloorType)0;
+
+    // count adj floor count with `cur`
+    for (s32 y = 0; y < prev.floors.size(); ++y)
+        for (s32 x = 0; x < prev.floors[y].size(); ++x)
+            if (prev.floors[y][x] == FloorType::FLOOR)
+            {
+                // add adjacent count to the neighbors
+                for (s32 cy = bn::max(y - 1, 0); cy <= bn::min(y + 1, prev.floors.size() - 1); ++cy)
+                    for (s32 cx = bn::max(x - 1, 0); cx <= bn::min(x + 1, prev.floors[cy].size() - 1); ++cx)
+                        if (!(cy == y && cx == x))
+                            cur.floors[cy][cx] = (FloorType)((u8)cur.floors[cy][cx] + 1);
+            }
+
+    // actually make tiles in `cur` a wall or floor
+    for (s32 y = 0; y < cur.floors.size(); ++y)
+        for (s32 x = 0; x < cur.floors[y].size(); ++x)
+        {
+            const u8 adjFloorCnt = (u8)cur.floors[y][x];
+            if (adjFloorCnt < 4)
+                cur.floors[y][x] = FloorType::WALL;
+            else if (adjFloorCnt >= 6)
+                cur.floors[y][x] = FloorType::FLOOR;
+            else
+                cur.floors[y][x] = prev.floors[y][x];
+        }
+}
+
+s32 Gen::_bfsCellular(s8 x, s8 y, bool removeMode, Room& room, Room& visited)
+{
+    if (removeMode)
+        room.floors[y][x] = FloorType::WALL;
+
+    bn::deque<BoardPos, utils::upperTwoPowOf(2 * ROOM_MAX_LEN + 4)> queue;
+    visited.floors[y][x] = (FloorType) true;
+    queue.push_back({x, y});
+    s32 blobSize = 1;
+
+    while (!queue.empty())
+    {
+        auto cur = queue.front();
+        queue.pop_front();
+
+        for (auto direction : UDLR)
+        {
+            const BoardPos candidate = {(s8)(cur.x + direction.x), (s8)(cur.y + direction.y)};
+            // check OOB
+            if (candidate.x < 0 || candidate.y < 0 || candidate.x >= room.floors[0].size() ||
+                candidate.y >= room.floors.size())
+                continue;
+            // check already visited
+            if ((bool)visited.floors[candidate.y][candidate.x])
+                continue;
+            // check wall
+            if (room.floors[candidate.y][candidate.x] == FloorType::WALL)
+                continue;
+
+            ++blobSize;
+            visited.floors[candidate.y][candidate.x] = (FloorType) true;
+            queue.push_back(candidate);
+
+            // Remove the floor cell by filling it with wall, when `removeMode` is enabled.
+            if (removeMode)
+                room.floors[candidate.y][candidate.x] = FloorType::WALL;
+        }
+    }
+
+    return blobSize;
+}
+
+} // namespace mp::game
@@ -37,9 +37,6 @@ constexpr s32 PLACE_ROOM_RETRY_COUNT = 5;
 constexpr s32 REGEN_ROOM_RETRY_COUNT = 5;
 constexpr s32 HALLWAY_MAX_LEN = 7;
 
-constexpr BoardPos UDLR[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
-constexpr BoardPos DIAGONAL[4] = {{-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
-
 } // namespace
 
 static void _debugLogRoom(const Gen::Room& room)
@@ -128,6 +125,32 @@ void Gen::generate(Board& board, iso_bn::random& rng)
     BN_PROFILER_STOP();
 }
 
+#ifdef MP_DEBUG
+void Gen::benchmarkKernels(iso_bn::random& rng)
+{
+    constexpr s32 BENCHMARK_COUNT = 16;
+
+    Room room, temp;
+    room.floors.resize(CELLULAR_ROOM_MAX_LEN, bn::vector<FloorType, ROOM_MAX_LEN>(CELLULAR_ROOM_MAX_LEN));
+    temp.floors.resize(CELLULAR_ROOM_MAX_LEN, bn::vector<FloorType, ROOM_MAX_LEN>(CELLULAR_ROOM_MAX_LEN));
+
+    for (s32 i = 0; i < BENCHMARK_COUNT; ++i)
+    {
+        for (auto& row : room.floors)
+            for (auto& elem : row)
+                elem = rng.get_fixed(1) <= CELLULAR_INIT_WALL_RATIO ? FloorType::WALL : FloorType::FLOOR;
+
+        BN_PROFILER_START("gen_cellular_smoothing");
+        _smoothCellularRoom(room, temp);
+        BN_PROFILER_STOP();
+
+        BN_PROFILER_START("gen_cellular_bfs");
+        _removeSmallBlobs(temp, room);
+        BN_PROFILER_STOP();
+    }
+}
+#endif
+
 void Gen::_clearWithWalls(Board& board) const
 {
     if constexpr ((u8)FloorType::WALL == 0)
@@ -289,68 +312,7 @@ bool Gen::_placeRoom(Room& room, Board& board, iso_bn::random& rng)
     return success;
 }
 
-static void _addAdjCountToNeighbors(const Gen::Room& prev, Gen::Room& cur, s32 x, s32 y)
-{
-    for (s32 cy = bn::max(y - 1, 0); cy <= bn::min(y + 1, prev.floors.size() - 1); ++cy)
-        for (s32 cx = bn::max(x - 1, 0); cx <= bn::min(x + 1, prev.floors[cy].size() - 1); ++cx)
-            if (!(cy == y && cx == x))
-                cur.floors[cy][cx] = (Gen::FloorType)((u8)cur.floors[cy][cx] + 1);
-}
-
-/**
- * @brief BFS used in Cellular automata room generation.
- * @param removeMode if enabled, fill in the passed small blob with walls.
- * @return size of the blob.
- */
-static s32 _bfsCellular(s8 x, s8 y, bool removeMode, Gen::Room& room, Gen::Room& visited)
-{
-    using Gen = Gen;
-
-    if (removeMode)
-        room.floors[y][x] = Gen::FloorType::WALL;
-
-    bn::deque<BoardPos, utils::upperTwoPowOf(2 * Gen::ROOM_MAX_LEN + 4)> queue;
-    visited.floors[y][x] = (Gen::FloorType) true;
-    queue.push_back({x, y});
-    s32 blobSize = 1;
-
-    while (!queue.empty())
-    {
-        auto cur = queue.front();
-        queue.pop_front();
-
-        for (auto direction : UDLR)
-        {
-            const BoardPos candidate = cur + direction;
-            // check OOB
-            if (candidate.x < 0 || candidate.y < 0 || candidate.x >= room.floors[0].size() ||
-                candidate.y >= room.floors.size())
-                continue;
-            // check already visited
-            if ((bool)visited.floors[candidate.y][candidate.x])
-                continue;
-            // check wall
-            if (room.floors[candidate.y][candidate.x] == Gen::FloorType::WALL)
-                continue;
-
-            ++blobSize;
-            visited.floors[candidate.y][candidate.x] = (Gen::FloorType) true;
-            queue.push_back(candidate);
-
-            // Remove the floor cell by filling it with wall, when `removeMode` is enabled.
-            if (removeMode)
-                room.floors[candidate.y][candidate.x] = Gen::FloorType::WALL;
-        }
-    }
-
-    return blobSize;
-}
-
-/**
- * @brief Find the biggest connected blob, and remove the other small blobs.
- * @return `false` if resulting room is smaller than `CELLULAR_ROOM_MIN_CELLS_COUNT`.
- */
-static bool _removeSmallBlobs(Gen::Room& room, Gen::Room& visited)
+bool Gen::_removeSmallBlobs(Room& room, Room& visited)
 {
     // clear visited
     for (auto& row : visited.floors)
@@ -472,29 +434,7 @@ auto Gen::_createCellularRoom(iso_bn::random& rng) const -> Room
         // smoothing: adjacent floor < 4 becomes a wall, adj floor >= 6 becomes a floor.
         for (s32 i = 0; i < SMOOTHING_COUNT; ++i)
         {
-            // clear `cur` with zero
-            for (auto& row : cur->floors)
-                for (auto& elem : row)
-                    elem = (FloorType)0;
-
-            // count adj floor count with `cur`
-            for (s32 y = 0; y < prev->floors.size(); ++y)
-                for (s32 x = 0; x < prev->floors[y].size(); ++x)
-                    if (prev->floors[y][x] == FloorType::FLOOR)
-                        _addAdjCountToNeighbors(*prev, *cur, x, y);
-
-            // actually make tiles in `cur` a wall or floor
-            for (s32 y = 0; y < cur->floors.size(); ++y)
-                for (s32 x = 0; x < cur->floors[y].size(); ++x)
-                {
-                    const u8 adjFloorCnt = (u8)cur->floors[y][x];
-                    if (adjFloorCnt < 4)
-                        cur->floors[y][x] = FloorType::WALL;
-                    else if (adjFloorCnt >= 6)
-                        cur->floors[y][x] = FloorType::FLOOR;
-                    else
-                        cur->floors[y][x] = prev->floors[y][x];
-                }
+            _smoothCellularRoom(*prev, *cur);
 
             // swap buffer
             bn::swap(prev, cur);
@@ -11,8 +11,8 @@
 #include "bn_assert.h"
 #include "bn_display.h"
 #include "bn_fixed_point.h"
+#include "bn_profiler.h"
 #include "bn_sprite_builder.h"
-#include "bn_string.h"
 
 #include "TextGen.hpp"
 #include "constants.hpp"
@@ -109,6 +109,9 @@ static s32 _getBellyGraphicsIndexFromBelly(s32 currentBelly, s32 maxBelly)
 Hud::Hud(TextGen& textGen, Settings& settings)
     : _textGen(textGen), _settings(settings), _currentBelly(BELLY_FALLBACK_VALUE), _maxBelly(BELLY_FALLBACK_VALUE),
       _bellyGaugeGraphicsIndex(_getBellyGraphicsIndexFromBelly(_currentBelly, _maxBelly)),
+      _currentBellyText(textGen.getDigitStrip(TextGen::FontKind::GALMURI_7), CURRENT_BELLY_POS,
+                        consts::UI_BG_PRIORITY),
+      _maxBellyText(textGen.getDigitStrip(TextGen::FontKind::GALMURI_7), MAX_BELLY_POS, consts::UI_BG_PRIORITY),
       _bellyGaugeSprite(bn::sprite_items::spr_belly_gauge.create_sprite(BELLY_GAUGE_POS, _bellyGaugeGraphicsIndex)),
       _settingsObserver(*this, settings),
       _inventorySquareSprite(bn::sprite_items::spr_inventory_square.create_sprite(consts::INVENTORY_POS))
@@ -130,8 +133,6 @@ void Hud::setVisible(bool newVisible)
             auto& textGen = _textGen.get(TextGen::FontKind::GALMURI_7);
             textGen.set_bg_priority(consts::UI_BG_PRIORITY);
             textGen.set_alignment(bn::sprite_text_generator::alignment_type::RIGHT);
-            textGen.generate(CURRENT_BELLY_POS, bn::to_string<4>(_currentBelly), _currentBellySprite);
-            textGen.generate(MAX_BELLY_POS, bn::to_string<4>(_maxBelly), _maxBellySprite);
 
             if (_bellyMiscSprites.empty())
             {
@@ -164,13 +165,13 @@ void Hud::setVisible(bool newVisible)
         }
         else
         {
-            _currentBellySprite.clear();
-            _maxBellySprite.clear();
             for (auto& sprite : _bellyMiscSprites)
                 sprite.set_visible(newVisible);
         }
     }
 
+    _currentBellyText.setVisible(newVisible);
+    _maxBellyText.setVisible(newVisible);
     _bellyGaugeSprite.set_visible(newVisible);
     _inventorySquareSprite.set_visible(newVisible);
 }
@@ -180,29 +181,13 @@ void Hud::setBelly(s32 currentBelly, s32 maxBelly)
     BN_ASSERT(0 <= currentBelly && currentBelly <= maxBelly, "invalid currentBelly(", currentBelly, ") and maxBelly(",
               maxBelly, ")");
 
-    const s32 newGraphicsIndex = _getBellyGraphicsIndexFromBelly(currentBelly, maxBelly);
+    BN_PROFILER_START("hud_set_belly");
 
-    if (isVisible())
-    {
-        if (currentBelly != _currentBelly)
-        {
-            _currentBellySprite.clear();
-
-            auto& textGen = _textGen.get(TextGen::FontKind::GALMURI_7);
-            textGen.set_bg_priority(consts::UI_BG_PRIORITY);
-            textGen.set_alignment(bn::sprite_text_generator::alignment_type::RIGHT);
-            textGen.generate(CURRENT_BELLY_POS, bn::to_string<4>(currentBelly), _currentBellySprite);
-        }
-        if (maxBelly != _maxBelly)
-        {
-            _maxBellySprite.clear();
+    const s32 newGraphicsIndex = _getBellyGraphicsIndexFromBelly(currentBelly, maxBelly);
 
-            auto& textGen = _textGen.get(TextGen::FontKind::GALMURI_7);
-            textGen.set_bg_priority(consts::UI_BG_PRIORITY);
-            textGen.set_alignment(bn::sprite_text_generator::alignment_type::RIGHT);
-            textGen.generate(MAX_BELLY_POS, bn::to_string<4>(maxBelly), _maxBellySprite);
-        }
-    }
+    // only swaps the digit tiles, so it's cheap enough to update even when not visible.
+    _currentBellyText.setNumber(currentBelly);
+    _maxBellyText.setNumber(maxBelly);
 
     // belly gauge should be updated even when not visible
     if (newGraphicsIndex != _bellyGaugeGraphicsIndex)
@@ -216,6 +201,8 @@ void Hud::setBelly(s32 currentBelly, s32 maxBelly)
     _currentBelly = currentBelly;
     _maxBelly = maxBelly;
     _bellyGaugeGraphicsIndex = newGraphicsIndex;
+
+    BN_PROFILER_STOP();
 }
 
 void Hud::clearInventory()
@@ -258,6 +245,9 @@ void Hud::_setInventorySquareEmpty(bool isEmpty)
 
 void Hud::_initGraphics()
 {
+    _currentBellyText.setNumber(_currentBelly);
+    _maxBellyText.setNumber(_maxBelly);
+
     setVisible(false);
     clearInventory();
     _bellyGaugeSprite.set_bg_priority(consts::UI_BG_PRIORITY);
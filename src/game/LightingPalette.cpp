@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/LightingPalette.hpp"
+
+#include "bn_assert.h"
+#include "bn_bg_palette_item.h"
+
+namespace mp::game
+{
+
+void LightingPalette::buildColors(const bn::bg_palette_item& srcPalette, Colors& destColors)
+{
+    BN_ASSERT(srcPalette.bpp() == bn::bpp_mode::BPP_4, "Lighting palette only supports 4bpp dungeon palette");
+    BN_ASSERT(srcPalette.colors_ref().size() == BANK_COLORS_COUNT, "Invalid dungeon palette colors count(",
+              srcPalette.colors_ref().size(), ")");
+
+    const auto& srcColors = srcPalette.colors_ref();
+
+    for (s32 level = 0; level < LIGHT_LEVELS; ++level)
+    {
+        // linearly darken to the half brightness, like the 50% blended black shadow.
+        const s32 numerator = 2 * LIGHT_LEVELS - 2 - level;
+        const s32 denominator = 2 * LIGHT_LEVELS - 2;
+
+        for (s32 i = 0; i < BANK_COLORS_COUNT; ++i)
+        {
+            const bn::color& src = srcColors[i];
+            destColors[level * BANK_COLORS_COUNT + i] =
+                bn::color(src.red() * numerator / denominator, src.green() * numerator / denominator,
+                          src.blue() * numerator / denominator);
+        }
+    }
+}
+
+} // namespace mp::game
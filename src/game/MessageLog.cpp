@@ -0,0 +1,350 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/MessageLog.hpp"
+
+#include "bn_algorithm.h"
+#include "bn_assert.h"
+#include "bn_bg_palette_item.h"
+#include "bn_display.h"
+#include "bn_memory.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_sprite_font.h"
+#include "bn_sprite_item.h"
+#include "bn_tile.h"
+
+#include "TextGen.hpp"
+#include "constants.hpp"
+#include "texts.hpp"
+
+namespace mp::game
+{
+
+namespace
+{
+
+constexpr s32 LOG_LEFT_MARGIN = 4;
+constexpr s32 LOG_TOP = 18;
+
+// sprite fonts start their glyphs from ' '(U+0020), and UTF-8 characters come after '~'(U+007E).
+constexpr s32 ASCII_GLYPHS_COUNT = '~' - ' ' + 1;
+
+constexpr s32 BLANK_TILE_INDEX = 0;
+
+static_assert(texts::glyphs::LANGUAGES_COUNT == Settings::TOTAL_LANGUAGES);
+
+using LangGlyphIds = bn::array<bn::span<const u8>, Settings::TOTAL_LANGUAGES>;
+
+constexpr LangGlyphIds findGlyphIds(const texts::LangTexts& langTexts)
+{
+    LangGlyphIds result{};
+    for (s32 lang = 0; lang < Settings::TOTAL_LANGUAGES; ++lang)
+    {
+        result[lang] = texts::glyphs::find(lang, langTexts[lang]);
+        BN_ASSERT(!result[lang].empty(), "Glyph ids not found for ", langTexts[lang]);
+    }
+    return result;
+}
+
+// glyph ids are looked up at compile time, so that it's only indexing at runtime.
+constexpr auto LOG_GLYPH_IDS = [] {
+    bn::array<LangGlyphIds, TOTAL_LOG_TEXTS> result{};
+    for (s32 kind = 0; kind < TOTAL_LOG_TEXTS; ++kind)
+        result[kind] = findGlyphIds(texts::LOG_TEXTS[kind]);
+    return result;
+}();
+
+constexpr auto ITEM_NAME_GLYPH_IDS = [] {
+    bn::array<LangGlyphIds, item::TOTAL_ITEMS> result{};
+    for (s32 kind = 0; kind < item::TOTAL_ITEMS; ++kind)
+        result[kind] = findGlyphIds(texts::ITEM_NAME_AND_DESC[kind].first);
+    return result;
+}();
+
+constexpr LangGlyphIds NUMBER_GLYPH_IDS = findGlyphIds(texts::NUMBER_GLYPHS);
+
+} // namespace
+
+MessageLogObserveSettings::MessageLogObserveSettings(MessageLog& log, Settings& settings)
+    : SettingsObserver(settings), _log(log)
+{
+}
+
+void MessageLogObserveSettings::onLangChange([[maybe_unused]] Settings::Language prevLang,
+                                             [[maybe_unused]] Settings::Language newLang)
+{
+    // Only the BG map is redrawn, no sprites involved.
+    _log._redrawVisibleLines();
+}
+
+MessageLog::MessageLog(TextGen& textGen, Settings& settings)
+    : _font(textGen.getFont(TextGen::FontKind::GALMURI_7)), _settings(settings),
+      _glyphRows(_font.item().shape_size().height() / 8), _cells{},
+      _mapItem(_cells[0], bn::size(MessageLog::COLUMNS, MessageLog::ROWS)),
+      _tiles(bn::regular_bg_tiles_ptr::allocate(
+          1 + bn::min(GLYPH_SLOTS_COUNT, texts::glyphs::MAX_GLYPHS - 1) * _glyphRows, bn::bpp_mode::BPP_4)),
+      _palette(bn::bg_palette_item(_font.item().palette_item().colors_ref(), bn::bpp_mode::BPP_4).create_palette()),
+      _bg(bn::regular_bg_ptr::create(0, 0, bn::regular_bg_map_ptr::create(_mapItem, _tiles, _palette))),
+      _bgMap(_bg.map()), _settingsObserver(*this, settings)
+{
+    BN_ASSERT(_font.item().shape_size().width() == 8, "Only 8px wide font is supported for the message log");
+
+    _initGraphics();
+}
+
+void MessageLog::update()
+{
+    if (_cellsReloadRequired)
+    {
+        _cellsReloadRequired = false;
+        _bgMap.reload_cells_ref();
+    }
+}
+
+void MessageLog::add(LogTextKind kind, const LogArg& arg)
+{
+    BN_ASSERT(kind < TOTAL_LOG_TEXTS, "Invalid LogTextKind(", kind, ")");
+
+    // push to the ring buffer, overwriting the oldest entry if it's full.
+    const s32 tail = (_entriesHead + _entriesCount) % CAPACITY;
+    _entries[tail] = Entry{kind, arg};
+    if (_entriesCount < CAPACITY)
+        ++_entriesCount;
+    else
+        _entriesHead = (_entriesHead + 1) % CAPACITY;
+    ++_addedCount;
+
+    // clear the line which just scrolled out of the view.
+    if (_addedCount > VISIBLE_LINES)
+        _clearLine(_getBgLine(_entriesCount - 1 - VISIBLE_LINES));
+
+    // draw the newly added line only.
+    if (!_drawLine(_getBgLine(_entriesCount - 1), _entries[tail]))
+        _redrawVisibleLines();
+
+    _updateBgPos();
+}
+
+void MessageLog::clear()
+{
+    _entriesHead = 0;
+    _entriesCount = 0;
+    _addedCount = 0;
+    _clearGlyphSlots();
+
+    bn::memory::clear(CELLS_COUNT, _cells[0]);
+    _cellsReloadRequired = true;
+
+    _updateBgPos();
+}
+
+bool MessageLog::isVisible() const
+{
+    return _bg.visible();
+}
+
+void MessageLog::setVisible(bool isVisible)
+{
+    _bg.set_visible(isVisible);
+}
+
+void MessageLog::_initGraphics()
+{
+    setVisible(false);
+    _bg.set_priority(consts::UI_BG_PRIORITY);
+
+    // blank tile for empty cells
+    bn::span<bn::tile> vram = *_tiles.vram();
+    vram[BLANK_TILE_INDEX] = bn::tile{};
+
+    _resolveGlyphs();
+    _clearGlyphSlots();
+    _updateBgPos();
+}
+
+void MessageLog::_resolveGlyphs()
+{
+    for (s32 lang = 0; lang < Settings::TOTAL_LANGUAGES; ++lang)
+    {
+        const auto& utf8Glyphs = texts::glyphs::GLYPHS[lang];
+        for (s32 glyphId = 0; glyphId < utf8Glyphs.size(); ++glyphId)
+            _glyphGraphicsIndexes[lang][glyphId] = (u16)_getGraphicsIndex(utf8Glyphs[glyphId]);
+    }
+}
+
+auto MessageLog::_getEntry(s32 order) const -> const Entry&
+{
+    BN_ASSERT(0 <= order && order < _entriesCount, "Invalid entry order(", order, ")");
+
+    return _entries[(_entriesHead + order) % CAPACITY];
+}
+
+s32 MessageLog::_getBgLine(s32 order) const
+{
+    const s32 bgLinesCount = ROWS / _glyphRows;
+    return (_addedCount - _entriesCount + order) % bgLinesCount;
+}
+
+void MessageLog::_redrawVisibleLines()
+{
+    // Start over with the empty glyph slots, so that the visible lines always fit in.
+    _clearGlyphSlots();
+
+    const s32 firstVisible = bn::max(0, _entriesCount - VISIBLE_LINES);
+    for (s32 order = firstVisible; order < _entriesCount; ++order)
+    {
+        const bool drawn = _drawLine(_getBgLine(order), _getEntry(order));
+        BN_ASSERT(drawn, "Visible lines don't fit in the glyph slots");
+    }
+}
+
+bool MessageLog::_drawLine(s32 bgLine, const Entry& entry)
+{
+    _clearLine(bgLine);
+
+    const auto lang = _settings.getLang();
+    return _drawGlyphs(bgLine, 0, LOG_GLYPH_IDS[entry.kind][lang], entry.arg) >= 0;
+}
+
+void MessageLog::_clearLine(s32 bgLine)
+{
+    for (s32 row = 0; row < _glyphRows; ++row)
+    {
+        const s32 y = bgLine * _glyphRows + row;
+        for (s32 x = 0; x < COLUMNS; ++x)
+            _cells[_mapItem.cell_index(x, y)] = BLANK_TILE_INDEX;
+    }
+    _cellsReloadRequired = true;
+}
+
+void MessageLog::_updateBgPos()
+{
+    const s32 firstVisibleAdded = bn::max(0, _addedCount - VISIBLE_LINES);
+    const s32 bgLinesCount = ROWS / _glyphRows;
+    const s32 firstVisibleBgY = (firstVisibleAdded % bgLinesCount) * _glyphRows * 8;
+
+    // place the first visible line on `LOG_TOP`, and the first column on `LOG_LEFT_MARGIN`.
+    _bg.set_position(LOG_LEFT_MARGIN - bn::display::width() / 2 + COLUMNS * 8 / 2,
+                     LOG_TOP - bn::display::height() / 2 + ROWS * 8 / 2 - firstVisibleBgY);
+}
+
+s32 MessageLog::_drawGlyphs(s32 bgLine, s32 column, bn::span<const u8> glyphIds, const LogArg& arg)
+{
+    _cellsReloadRequired = true;
+
+    for (const u8 glyphId : glyphIds)
+    {
+        if (glyphId == texts::glyphs::PLACEHOLDER_ID)
+            column = _drawArg(bgLine, column, arg);
+        else
+            column = _drawGlyph(bgLine, column, glyphId);
+
+        if (column < 0)
+            return -1;
+    }
+
+    return column;
+}
+
+s32 MessageLog::_drawArg(s32 bgLine, s32 column, const LogArg& arg)
+{
+    const auto lang = _settings.getLang();
+
+    switch (arg.type)
+    {
+    case LogArg::Type::NONE:
+        return column;
+    case LogArg::Type::NUMBER: {
+        BN_ASSERT(arg.value >= 0, "Negative number(", arg.value, ") can't be drawn");
+
+        // most significant digit first
+        s32 divisor = 1;
+        while (arg.value / divisor >= 10)
+            divisor *= 10;
+        for (; divisor > 0 && column >= 0; divisor /= 10)
+            column = _drawGlyph(bgLine, column, NUMBER_GLYPH_IDS[lang][arg.value / divisor % 10]);
+        return column;
+    }
+    case LogArg::Type::ITEM_NAME:
+        BN_ASSERT(0 <= arg.value && arg.value < item::TOTAL_ITEMS, "Invalid item kind(", arg.value, ")");
+        return _drawGlyphs(bgLine, column, ITEM_NAME_GLYPH_IDS[arg.value][lang], {});
+    default:
+        BN_ERROR("Invalid LogArg::Type(", (s32)arg.type, ")");
+    }
+
+    return column;
+}
+
+s32 MessageLog::_drawGlyph(s32 bgLine, s32 column, u8 glyphId)
+{
+    if (column >= LINE_MAX_CHARS)
+        return column;
+
+    // leave the cell blank for space
+    if (glyphId != texts::glyphs::SPACE_ID)
+    {
+        const s32 slot = _findOrUploadGlyph(glyphId);
+        if (slot < 0)
+            return -1;
+
+        for (s32 row = 0; row < _glyphRows; ++row)
+        {
+            bn::regular_bg_map_cell_info cellInfo;
+            cellInfo.set_tile_index(1 + slot * _glyphRows + row);
+            _cells[_mapItem.cell_index(column, bgLine * _glyphRows + row)] = cellInfo.cell();
+        }
+    }
+
+    return column + 1;
+}
+
+s32 MessageLog::_findOrUploadGlyph(u8 glyphId)
+{
+    if (_glyphSlots[glyphId] >= 0)
+        return _glyphSlots[glyphId];
+
+    if (_usedGlyphSlotsCount >= GLYPH_SLOTS_COUNT)
+        return -1;
+
+    const s32 slot = _usedGlyphSlotsCount++;
+    _glyphSlots[glyphId] = (s16)slot;
+
+    // 8px wide sprite glyph tiles are laid out from top to bottom, same as how they're placed on the BG.
+    const s32 graphicsIndex = _glyphGraphicsIndexes[_settings.getLang()][glyphId];
+    const auto& glyphTiles = _font.item().tiles_item().tiles_ref();
+    bn::span<bn::tile> vram = *_tiles.vram();
+    for (s32 row = 0; row < _glyphRows; ++row)
+        vram[1 + slot * _glyphRows + row] = glyphTiles[graphicsIndex * _glyphRows + row];
+
+    return slot;
+}
+
+void MessageLog::_clearGlyphSlots()
+{
+    _glyphSlots.fill(-1);
+    _usedGlyphSlotsCount = 0;
+}
+
+s32 MessageLog::_getGraphicsIndex(const bn::string_view& utf8Char) const
+{
+    if (utf8Char.size() == 1)
+    {
+        BN_ASSERT(' ' <= utf8Char[0] && utf8Char[0] <= '~', "Invalid ASCII char(", (s32)utf8Char[0], ")");
+        return utf8Char[0] - ' ';
+    }
+
+    const auto& utf8Chars = _font.utf8_characters_ref();
+    for (s32 i = 0; i < utf8Chars.size(); ++i)
+        if (utf8Chars[i] == utf8Char)
+            return ASCII_GLYPHS_COUNT + i;
+
+    BN_ERROR("UTF-8 char not found in the font: ", utf8Char);
+    return '?' - ' ';
+}
+
+} // namespace mp::game
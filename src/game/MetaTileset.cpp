@@ -8,8 +8,6 @@
 
 #include "game/MetaTileset.hpp"
 
-#include "bn_log.h"
-
 #include "bn_regular_bg_items_bg_dungeon_tileset_placeholder.h"
 
 namespace mp::game
@@ -45,94 +43,38 @@ auto MetaTileset::getCell(const DungeonFloor::Neighbor3x3& neighbors,
                           const DungeonFloor::NeighborDiscover3x3& discovers, s32 bgTileX, s32 bgTileY) const
     -> bn::regular_bg_map_cell
 {
-    TileIndex idx = _calcMetaTileIndex(neighbors, discovers);
+    TileIndex idx = calcMetaTileIndex(neighbors, discovers);
     return _metaTiles[idx].getCell(bgTileX, bgTileY);
 }
 
-auto MetaTileset::_calcMetaTileIndex(const DungeonFloor::Neighbor3x3& neighbors,
-                                     const DungeonFloor::NeighborDiscover3x3& discovers) -> TileIndex
+auto MetaTileset::calcUsedMetaTiles(const DungeonFloor& dungeonFloor) const -> MetaTileFlags
 {
-    using FloorType = DungeonFloor::Type;
-
-    // TODO: load wall/floor variations, instead of default one.
-    // TODO: darken the floors when they are not discovered yet.
+    MetaTileFlags result;
 
-    // if center tile is a floor, just return the floor tile.
-    if (neighbors[1][1] == FloorType::FLOOR)
-        return 26;
+    // invalid 'X' tile is always used, to show the unexpected meta-tile.
+    result.set(0);
 
-    // top-left to bottom-right wall flags
-    s32 wallFlags = 0;
+    DungeonFloor::NeighborDiscover3x3 allDiscovered;
+    DungeonFloor::NeighborDiscover3x3 noneDiscovered;
     for (s32 y = 0; y < 3; ++y)
-        for (s32 x = 0; x < 3; ++x)
-            if (neighbors[y][x] == FloorType::WALL)
-                wallFlags += (1 << (3 * y + x));
+    {
+        allDiscovered[y].set();
+        noneDiscovered[y].reset();
+    }
 
-    switch (wallFlags)
+    // 1 more tiles for each side, which are out of the floor but can be seen on screen.
+    for (s32 y = -1; y <= DungeonFloor::ROWS; ++y)
     {
-    // full wall
-    case 511:
-        return 1;
-
-    // corner (inner) walls
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7):
-        return 6; // top-left
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8):
-        return 7; // top-right
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8):
-        return 12; // bottom-left
-    case (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8):
-        return 13; // bottom-right
-
-    // corner (outer) walls
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 0):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 8):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 0) + (1 << 8):
-        return 22; // bottom-left
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 2):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 6):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 2) + (1 << 6):
-        return 23; // bottom-right
-    case (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8):
-    case (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 2):
-    case (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 6):
-    case (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 2) + (1 << 6):
-        return 24; // top-left
-    case (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7):
-    case (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 0):
-    case (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 8):
-    case (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 0) + (1 << 8):
-        return 25; // top-right
-
-    // straight walls
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5):
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6):
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 8):
-    case (1 << 0) + (1 << 1) + (1 << 2) + (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 8):
-        return 2; // top
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 2):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 8):
-    case (1 << 0) + (1 << 1) + (1 << 3) + (1 << 4) + (1 << 6) + (1 << 7) + (1 << 2) + (1 << 8):
-        return 14; // left
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 0):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 6):
-    case (1 << 1) + (1 << 2) + (1 << 4) + (1 << 5) + (1 << 7) + (1 << 8) + (1 << 0) + (1 << 6):
-        return 18; // right
-    case (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8):
-    case (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8) + (1 << 0):
-    case (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8) + (1 << 2):
-    case (1 << 3) + (1 << 4) + (1 << 5) + (1 << 6) + (1 << 7) + (1 << 8) + (1 << 0) + (1 << 2):
-        return 8; // bottom
-
-    default:
-        // BN_LOG("invalid neighbor wall flag(", wallFlags, ")");
-        break;
+        for (s32 x = -1; x <= DungeonFloor::COLUMNS; ++x)
+        {
+            const DungeonFloor::Neighbor3x3 neighbors = dungeonFloor.getNeighborsOf(x, y);
+            const s32 variant = dungeonFloor.getCellHash(x, y) & (VARIANTS_COUNT - 1);
+            result.set(getVariant(calcMetaTileIndex(neighbors, allDiscovered), variant));
+            result.set(getVariant(calcMetaTileIndex(neighbors, noneDiscovered), variant));
+        }
     }
-    return 0;
+
+    return result;
 }
 
 } // namespace mp::game
@@ -9,15 +9,18 @@
 #include "game/MiniMap.hpp"
 
 #include "bn_affine_bg_map_cell_info.h"
+#include "bn_algorithm.h"
 #include "bn_assert.h"
 #include "bn_fixed_point.h"
 #include "bn_log.h"
 #include "bn_profiler.h"
 
+#include "Arena.hpp"
 #include "game/DungeonFloor.hpp"
 #include "game/mob/Monster.hpp"
 
 #include "bn_affine_bg_items_bg_minimap.h"
+#include "bn_sprite_items_spr_minimap_markers.h"
 #include "bn_sprite_items_spr_minimap_player_cursor.h"
 
 namespace mp::game
@@ -26,7 +29,25 @@ namespace mp::game
 namespace
 {
 constexpr s32 PLAYER_CURSOR_FLICKER_FRAMES = 8;
-constexpr bn::fixed_point PLAYER_CURSOR_POS = {-40, 0};
+
+constexpr s32 CELL_SIZE_IN_PIXELS = 8;
+
+constexpr bn::fixed ZOOM_SCALES[(s32)MiniMap::Zoom::TOTAL_ZOOMS] = {1, 0.5, 0.25};
+
+// graphics indexes of `spr_minimap_markers`
+constexpr s32 ITEM_MARKER_GRAPHICS = 0;
+constexpr s32 ENEMY_MARKER_GRAPHICS = 1;
+constexpr s32 NO_MARKER = -1;
+
+// marker of each `StampKind`, which is only for the items & the enemies.
+constexpr s32 MARKER_GRAPHICS_LUT[(s32)MiniMap::StampKind::TOTAL_STAMP_KINDS] = {
+    NO_MARKER, NO_MARKER, ITEM_MARKER_GRAPHICS, NO_MARKER, ENEMY_MARKER_GRAPHICS, ENEMY_MARKER_GRAPHICS,
+};
+
+constexpr u8 _stampBit(MiniMap::StampKind kind)
+{
+    return (u8)(1 << (s32)kind);
+}
 } // namespace
 
 enum MiniMap::TileIndex : u8
@@ -94,13 +115,22 @@ enum MiniMap::TileIndex : u8
     WALL3_CLOSED,
 };
 
-MiniMap::MiniMap()
-    : _cells{}, _mapItem(_cells[0], bn::size(MiniMap::COLUMNS, MiniMap::ROWS)),
+MiniMap::MiniMap(Arena& arena)
+    : _cells(arena.create<Cells>().cells), _mapItem(_cells[0], bn::size(MiniMap::COLUMNS, MiniMap::ROWS)),
       _bgItem(bn::affine_bg_items::bg_minimap.tiles_item(), bn::affine_bg_items::bg_minimap.palette_item(), _mapItem),
       _bg(_bgItem.create_bg(0, 0)), _bgMap(_bg.map()),
-      _playerCursor(bn::sprite_items::spr_minimap_player_cursor.create_sprite(PLAYER_CURSOR_POS)),
-      _playerCursorFlickerAction(_playerCursor, PLAYER_CURSOR_FLICKER_FRAMES)
+      _playerCursor(bn::sprite_items::spr_minimap_player_cursor.create_sprite(0, 0)),
+      _playerCursorFlickerAction(_playerCursor, PLAYER_CURSOR_FLICKER_FRAMES),
+      _stampMasks(arena.create<StampMasks>().masks)
 {
+    // markers are created once, so that opening the map doesn't allocate anything.
+    for (s32 i = 0; i < MARKERS_MAX_COUNT; ++i)
+    {
+        bn::sprite_ptr marker = bn::sprite_items::spr_minimap_markers.create_sprite(0, 0);
+        marker.set_bg_priority(consts::MINI_MAP_BG_PRIORITY);
+        _markers.push_back(bn::move(marker));
+    }
+
     _initGraphics();
 }
 
@@ -111,29 +141,103 @@ void MiniMap::update()
         _playerCursorFlickerAction.update();
     }
 
-    if (_cellsReloadRequired)
+    if (_redrawFloor)
+        _redrawPendingRows();
+
+    // the stamps change the cells every turn, so the cells are reloaded only while the map is shown.
+    if (_cellsReloadRequired && isVisible())
+        _reloadCells();
+}
+
+void MiniMap::updateBgPos(const mob::Monster& player)
+{
+    _playerBoardPos = player.getBoardPos();
+    _updatePositions();
+}
+
+void MiniMap::addStamp(StampKind kind, const BoardPos& boardPos, const DungeonFloor& dungeonFloor)
+{
+    BN_ASSERT(!_stamps.full(), "Too many stamps (", _stamps.size(), ")");
+
+    _stamps.push_back({boardPos, kind});
+    _stampMasks[_mapItem.cell_index(boardPos.x, boardPos.y)] |= _stampBit(kind);
+    redrawCell(boardPos.x, boardPos.y, dungeonFloor);
+
+    if (isVisible())
+        _updateMarkers();
+}
+
+void MiniMap::removeStamp(StampKind kind, const BoardPos& boardPos, const DungeonFloor& dungeonFloor)
+{
+    for (auto it = _stamps.begin(); it != _stamps.end(); ++it)
     {
-        _cellsReloadRequired = false;
-        _bgMap.reload_cells_ref();
+        if (it->kind == kind && it->boardPos == boardPos)
+        {
+            _stamps.erase(it);
+            // another stamp of the same kind might be left on the cell.
+            if (!_hasStamp(kind, boardPos))
+                _stampMasks[_mapItem.cell_index(boardPos.x, boardPos.y)] &= ~_stampBit(kind);
+            redrawCell(boardPos.x, boardPos.y, dungeonFloor);
+
+            if (isVisible())
+                _updateMarkers();
+            return;
+        }
     }
+
+    BN_ERROR("Stamp(", (s32)kind, ") not found on (", boardPos.x, ", ", boardPos.y, ")");
 }
 
-void MiniMap::updateBgPos(const mob::Monster& player)
+void MiniMap::moveStamp(StampKind kind, const BoardPos& from, const BoardPos& to, const DungeonFloor& dungeonFloor)
+{
+    for (Stamp& stamp : _stamps)
+    {
+        if (stamp.kind == kind && stamp.boardPos == from)
+        {
+            stamp.boardPos = to;
+            if (!_hasStamp(kind, from))
+                _stampMasks[_mapItem.cell_index(from.x, from.y)] &= ~_stampBit(kind);
+            _stampMasks[_mapItem.cell_index(to.x, to.y)] |= _stampBit(kind);
+            redrawCell(from.x, from.y, dungeonFloor);
+            redrawCell(to.x, to.y, dungeonFloor);
+
+            if (isVisible())
+                _updateMarkers();
+            return;
+        }
+    }
+
+    BN_ERROR("Stamp(", (s32)kind, ") not found on (", from.x, ", ", from.y, ")");
+}
+
+void MiniMap::clearStamps()
 {
-    const auto& playerPos = player.getBoardPos();
+    for (const Stamp& stamp : _stamps)
+        _stampMasks[_mapItem.cell_index(stamp.boardPos.x, stamp.boardPos.y)] = 0;
+    _stamps.clear();
 
-    _bg.set_position(PLAYER_CURSOR_POS.x() + COLUMNS * 4 / 2 - 2 - 4 * playerPos.x,
-                     PLAYER_CURSOR_POS.y() + ROWS * 4 / 2 - 2 - 4 * playerPos.y);
+    _markerBoardPositions.clear();
+    setVisible(isVisible());
 }
 
 void MiniMap::redrawAll(const DungeonFloor& dungeonFloor)
 {
-    BN_PROFILER_START("minimap_redraw_all");
+    _redrawFloor = &dungeonFloor;
+    _redrawRow = 0;
+}
 
-    _cellsReloadRequired = true;
-    for (s32 y = 0; y < ROWS; ++y)
+void MiniMap::_redrawPendingRows()
+{
+    BN_PROFILER_START("minimap_redraw_rows");
+
+    const s32 endRow = bn::min(_redrawRow + REDRAW_ROWS_PER_FRAME, ROWS);
+    for (s32 y = _redrawRow; y < endRow; ++y)
         for (s32 x = 0; x < COLUMNS; ++x)
-            redrawCell(x, y, dungeonFloor);
+            redrawCell(x, y, *_redrawFloor);
+
+    _redrawRow = endRow;
+    if (_redrawRow == ROWS)
+        _redrawFloor = nullptr;
 
     BN_PROFILER_STOP();
 }
@@ -149,6 +253,12 @@ void MiniMap::redrawCell(s32 x, s32 y, const DungeonFloor& dungeonFloor)
     cell = cellInfo.cell();
 }
 
+void MiniMap::_reloadCells()
+{
+    _cellsReloadRequired = false;
+    _bgMap.reload_cells_ref();
+}
+
 bool MiniMap::isVisible() const
 {
     return _bg.visible();
@@ -156,17 +266,113 @@ bool MiniMap::isVisible() const
 
 void MiniMap::setVisible(bool isVisible)
 {
+    // markers are assigned only while the map is shown, as the stamps move every turn.
+    if (isVisible && !this->isVisible())
+    {
+        _updateMarkers();
+
+        // reload the cells changed while the map was hidden.
+        if (_cellsReloadRequired)
+            _reloadCells();
+    }
+
     _bg.set_visible(isVisible);
     _playerCursor.set_visible(isVisible);
+
+    for (s32 i = 0; i < _markers.size(); ++i)
+        _markers[i].set_visible(isVisible && i < _markerBoardPositions.size());
+}
+
+auto MiniMap::getZoom() const -> Zoom
+{
+    return _zoom;
+}
+
+void MiniMap::setZoom(Zoom zoom)
+{
+    BN_ASSERT(0 <= (s32)zoom && zoom < Zoom::TOTAL_ZOOMS, "Invalid zoom(", (s32)zoom, ")");
+
+    _zoom = zoom;
+    _updatePositions();
+}
+
+void MiniMap::zoomIn()
+{
+    if (_zoom != Zoom::X1)
+        setZoom((Zoom)((s32)_zoom - 1));
+}
+
+void MiniMap::zoomOut()
+{
+    if ((s32)_zoom + 1 < (s32)Zoom::TOTAL_ZOOMS)
+        setZoom((Zoom)((s32)_zoom + 1));
 }
 
 void MiniMap::_initGraphics()
 {
     setVisible(false);
 
-    _bg.set_scale(0.5);
     _bg.set_wrapping_enabled(false);
     _bg.set_priority(consts::MINI_MAP_BG_PRIORITY);
+    _playerCursor.set_bg_priority(consts::MINI_MAP_BG_PRIORITY);
+
+    _updatePositions();
+}
+
+void MiniMap::_updatePositions()
+{
+    const bn::fixed scale = ZOOM_SCALES[(s32)_zoom];
+    const bn::point focus = _getFocus();
+
+    _bg.set_scale(scale);
+    _bg.set_position(scale * -focus.x(), scale * -focus.y());
+
+    _playerCursor.set_position(_getScreenPos(_playerBoardPos));
+    for (s32 i = 0; i < _markerBoardPositions.size(); ++i)
+        _markers[i].set_position(_getScreenPos(_markerBoardPositions[i]));
+}
+
+void MiniMap::_updateMarkers()
+{
+    _markerBoardPositions.clear();
+
+    for (const Stamp& stamp : _stamps)
+    {
+        const s32 graphicsIndex = MARKER_GRAPHICS_LUT[(s32)stamp.kind];
+        if (graphicsIndex == NO_MARKER)
+            continue;
+        if (_markerBoardPositions.full())
+            break;
+
+        _markers[_markerBoardPositions.size()].set_tiles(bn::sprite_items::spr_minimap_markers.tiles_item(),
+                                                         graphicsIndex);
+        _markerBoardPositions.push_back(stamp.boardPos);
+    }
+
+    for (s32 i = 0; i < _markers.size(); ++i)
+        _markers[i].set_visible(isVisible() && i < _markerBoardPositions.size());
+    _updatePositions();
+}
+
+auto MiniMap::_getFocus() const -> bn::point
+{
+    // whole floor fits in the screen with the smallest zoom level.
+    if (_zoom == Zoom::X1_4)
+        return {0, 0};
+
+    return {_playerBoardPos.x * CELL_SIZE_IN_PIXELS + CELL_SIZE_IN_PIXELS / 2 - COLUMNS * CELL_SIZE_IN_PIXELS / 2,
+            _playerBoardPos.y * CELL_SIZE_IN_PIXELS + CELL_SIZE_IN_PIXELS / 2 - ROWS * CELL_SIZE_IN_PIXELS / 2};
+}
+
+auto MiniMap::_getScreenPos(const BoardPos& boardPos) const -> bn::fixed_point
+{
+    const bn::fixed scale = ZOOM_SCALES[(s32)_zoom];
+    const bn::point focus = _getFocus();
+
+    // BG is scaled from its center, which is the center of the floor.
+    const s32 x = boardPos.x * CELL_SIZE_IN_PIXELS + CELL_SIZE_IN_PIXELS / 2 - COLUMNS * CELL_SIZE_IN_PIXELS / 2;
+    const s32 y = boardPos.y * CELL_SIZE_IN_PIXELS + CELL_SIZE_IN_PIXELS / 2 - ROWS * CELL_SIZE_IN_PIXELS / 2;
+    return {scale * (x - focus.x()), scale * (y - focus.y())};
 }
 
 MiniMap::TileIndex MiniMap::_calculateTileIndex(s32 x, s32 y, const DungeonFloor& dungeonFloor) const
@@ -183,9 +389,19 @@ MiniMap::TileIndex MiniMap::_calculateTileIndex(s32 x, s32 y, const DungeonFloor
     auto right = (x + 1 < COLUMNS) ? dungeonFloor.getFloorTypeOf(x + 1, y) : Cell::WALL;
 
     // TODO: Player의 시야 고려하여 dithering 여부 결정
-    // TODO: 해당 cell 위에 있는 Actor/Item도 고려하여 그릴 타일 결정
     // TODO: 특수 능력으로 본 지형은 회색 타일로 그림
 
+    // stamped entity is drawn over the terrain.
+    const StampKind stampKind = _findTopStampKind(x, y);
+    if (stampKind != StampKind::TOTAL_STAMP_KINDS)
+    {
+        constexpr TileIndex STAMP_TILE_LUT[(s32)StampKind::TOTAL_STAMP_KINDS] = {
+            ELEVATOR, TRAP, ITEM, NPC, ENEMY, BOSS,
+        };
+
+        return STAMP_TILE_LUT[(s32)stampKind];
+    }
+
     TileIndex result = TileIndex::EMPTY;
 
     if (cur == Cell::FLOOR)
@@ -220,4 +436,25 @@ MiniMap::TileIndex MiniMap::_calculateTileIndex(s32 x, s32 y, const DungeonFloor
     return result;
 }
 
+auto MiniMap::_findTopStampKind(s32 x, s32 y) const -> StampKind
+{
+    const u8 mask = _stampMasks[_mapItem.cell_index(x, y)];
+
+    // highest set bit is the highest priority kind.
+    for (s32 kind = (s32)StampKind::TOTAL_STAMP_KINDS - 1; kind >= 0; --kind)
+        if (mask & _stampBit((StampKind)kind))
+            return (StampKind)kind;
+
+    return StampKind::TOTAL_STAMP_KINDS;
+}
+
+bool MiniMap::_hasStamp(StampKind kind, const BoardPos& boardPos) const
+{
+    for (const Stamp& stamp : _stamps)
+        if (stamp.kind == kind && stamp.boardPos == boardPos)
+            return true;
+
+    return false;
+}
+
 } // namespace mp::game
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/OccupancyBoard.hpp"
+
+#include "bn_assert.h"
+
+namespace mp::game
+{
+
+namespace
+{
+
+s32 _getWordIndex(const BoardPos& pos)
+{
+    using Board = OccupancyBoard;
+    BN_ASSERT(0 <= pos.x && pos.x < Board::COLUMNS && 0 <= pos.y && pos.y < Board::ROWS, "Invalid pos(", pos.x, ", ",
+              pos.y, ")");
+
+    return pos.y * Board::WORDS_PER_ROW + pos.x / 32;
+}
+
+u32 _getBit(const BoardPos& pos)
+{
+    return 1u << (pos.x % 32);
+}
+
+} // namespace
+
+OccupancyBoard::OccupancyBoard()
+{
+    clear();
+}
+
+bool OccupancyBoard::has(const BoardPos& pos) const
+{
+    return _words[_getWordIndex(pos)] & _getBit(pos);
+}
+
+void OccupancyBoard::set(const BoardPos& pos)
+{
+    _words[_getWordIndex(pos)] |= _getBit(pos);
+}
+
+void OccupancyBoard::reset(const BoardPos& pos)
+{
+    _words[_getWordIndex(pos)] &= ~_getBit(pos);
+}
+
+void OccupancyBoard::move(const BoardPos& from, const BoardPos& to)
+{
+    reset(from);
+    set(to);
+}
+
+void OccupancyBoard::clear()
+{
+    _words.fill(0);
+}
+
+} // namespace mp::game
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/TurnScheduler.hpp"
+
+#include "bn_assert.h"
+
+namespace mp::game
+{
+
+TurnScheduler::TurnScheduler()
+{
+    clear();
+}
+
+void TurnScheduler::clear()
+{
+    _tick = 0;
+    _bucketHeads.fill(NIL);
+    _bucketTails.fill(NIL);
+    _nexts.fill(NIL);
+    _prevs.fill(NIL);
+    _scheduledTicks.fill(0);
+    _speeds.fill(mob::MonsterSpeed::NORMAL);
+    _isScheduled.fill(false);
+}
+
+void TurnScheduler::add(u8 actor, mob::MonsterSpeed speed)
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+    BN_ASSERT(!_isScheduled[actor], "actor(", actor, ") is already scheduled");
+
+    _speeds[actor] = speed;
+    reschedule(actor);
+}
+
+void TurnScheduler::remove(u8 actor)
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+
+    if (_isScheduled[actor])
+        _unlink(actor);
+}
+
+void TurnScheduler::reschedule(u8 actor)
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+    BN_ASSERT(!_isScheduled[actor], "actor(", actor, ") is already scheduled");
+
+    _push(actor, (u16)(_tick + DELAYS[(s32)_speeds[actor]]));
+}
+
+u8 TurnScheduler::popNext()
+{
+    // every actor is scheduled within `WHEEL_SIZE` ticks, so this loop ends in one round at most.
+    for (s32 i = 0; i < WHEEL_SIZE; ++i)
+    {
+        const s8 head = _bucketHeads[_tick & (WHEEL_SIZE - 1)];
+        if (head != NIL)
+        {
+            _unlink((u8)head);
+            return (u8)head;
+        }
+        ++_tick;
+    }
+
+    BN_ERROR("No actor is scheduled");
+    return PLAYER_ACTOR;
+}
+
+bool TurnScheduler::isScheduled(u8 actor) const
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+
+    return _isScheduled[actor];
+}
+
+auto TurnScheduler::getSpeed(u8 actor) const -> mob::MonsterSpeed
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+
+    return _speeds[actor];
+}
+
+void TurnScheduler::setSpeed(u8 actor, mob::MonsterSpeed speed)
+{
+    BN_ASSERT(actor < ACTORS_COUNT, "Invalid actor(", actor, ")");
+
+    _speeds[actor] = speed;
+}
+
+u16 TurnScheduler::getTick() const
+{
+    return _tick;
+}
+
+void TurnScheduler::_push(u8 actor, u16 tick)
+{
+    const s32 bucket = tick & (WHEEL_SIZE - 1);
+
+    _scheduledTicks[actor] = tick;
+    _isScheduled[actor] = true;
+    _nexts[actor] = NIL;
+    _prevs[actor] = _bucketTails[bucket];
+
+    if (_bucketTails[bucket] != NIL)
+        _nexts[_bucketTails[bucket]] = (s8)actor;
+    else
+        _bucketHeads[bucket] = (s8)actor;
+    _bucketTails[bucket] = (s8)actor;
+}
+
+void TurnScheduler::_unlink(u8 actor)
+{
+    const s32 bucket = _scheduledTicks[actor] & (WHEEL_SIZE - 1);
+    const s8 prev = _prevs[actor];
+    const s8 next = _nexts[actor];
+
+    if (prev != NIL)
+        _nexts[prev] = next;
+    else
+        _bucketHeads[bucket] = next;
+
+    if (next != NIL)
+        _prevs[next] = prev;
+    else
+        _bucketTails[bucket] = prev;
+
+    _nexts[actor] = NIL;
+    _prevs[actor] = NIL;
+    _isScheduled[actor] = false;
+}
+
+} // namespace mp::game
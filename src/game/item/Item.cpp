@@ -18,43 +18,18 @@
 namespace mp::game::item
 {
 
-Item::Item(ItemKind itemKind, const BoardPos& boardPos, const mob::Player& player, const bn::camera_ptr& camera)
-    : _info(ItemInfo::fromKind(itemKind)), _playerPos(player.getBoardPos()),
-      _sprite(_info.spriteItem.create_sprite(0, 0, _info.graphicsIndex)), _pos(boardPos)
+Item::Item(const ItemRecord& record, const BoardPos& boardPos, const mob::Player& player,
+           const bn::camera_ptr& camera)
+    : _info(ItemInfo::fromKind(record.kind)), _playerPos(player.getBoardPos()),
+      _sprite(_info.spriteItem.create_sprite(0, 0, _info.graphicsIndex)), _pos(boardPos), _flags(record.flags)
 {
-    _initGraphicsForDungeonFloorItem(camera);
-}
-
-Item::Item(ItemKind itemKind, const mob::Player& player)
-    : _info(ItemInfo::fromKind(itemKind)), _playerPos(player.getBoardPos()),
-      _sprite(_info.spriteItem.create_sprite(0, 0, _info.graphicsIndex)), _pos({0, 0})
-{
-    _initGraphicsForInventoryItem();
+    _initGraphics(camera);
 }
 
 Item::Item(Item&& other)
-    : _info(other._info), _playerPos(other._playerPos), _sprite(bn::move(other._sprite)), _pos(other._pos)
-{
-}
-
-bool Item::isInInventory() const
-{
-    return !_sprite.camera().has_value();
-}
-
-void Item::moveSpriteToDungeonFloor(const BoardPos& boardPos, const bn::camera_ptr& camera)
-{
-    _pos = boardPos;
-    _sprite.set_camera(camera);
-    _sprite.set_bg_priority(consts::DUNGEON_BG_PRIORITY);
-    _updateSpritePos();
-}
-
-void Item::moveSpriteToInventory()
+    : _info(other._info), _playerPos(other._playerPos), _sprite(bn::move(other._sprite)), _pos(other._pos),
+      _flags(other._flags)
 {
-    _sprite.remove_camera();
-    _sprite.set_bg_priority(consts::UI_BG_PRIORITY);
-    _updateSpritePos();
 }
 
 auto Item::getBoardPos() const -> const BoardPos&
@@ -65,8 +40,7 @@ auto Item::getBoardPos() const -> const BoardPos&
 void Item::setBoardPos(const BoardPos& pos)
 {
     _pos = pos;
-    if (!isInInventory())
-        _updateSpritePos();
+    _updateSpritePos();
 }
 
 auto Item::getItemInfo() const -> const ItemInfo&
@@ -74,33 +48,32 @@ auto Item::getItemInfo() const -> const ItemInfo&
     return _info;
 }
 
-void Item::_initGraphicsForInventoryItem()
+auto Item::getRecord() const -> ItemRecord
 {
-    _sprite.set_z_order(consts::ITEM_Z_ORDER);
-    moveSpriteToInventory();
+    return ItemRecord{_info.kind, _flags};
 }
 
-void Item::_initGraphicsForDungeonFloorItem(const bn::camera_ptr& camera)
+auto Item::getSprite() const -> const bn::sprite_ptr&
+{
+    return _sprite;
+}
+
+void Item::_initGraphics(const bn::camera_ptr& camera)
 {
     _sprite.set_z_order(consts::ITEM_Z_ORDER);
-    moveSpriteToDungeonFloor(_pos, camera);
+    _sprite.set_camera(camera);
+    _sprite.set_bg_priority(consts::DUNGEON_BG_PRIORITY);
+    _updateSpritePos();
 }
 
 void Item::_updateSpritePos()
 {
-    if (isInInventory())
-    {
-        _sprite.set_position(consts::INVENTORY_POS);
-    }
-    else // item is on dungeon floor
-    {
-        // update sprite position relative to the player.
-        const BoardPos diff = _pos - _playerPos;
-        auto spritePos = _sprite.camera()->position();
-        spritePos += bn::fixed_point{(s32)diff.x * consts::DUNGEON_META_TILE_SIZE.width(),
-                                     (s32)diff.y * consts::DUNGEON_META_TILE_SIZE.height()};
-        _sprite.set_position(spritePos);
-    }
+    // update sprite position relative to the player.
+    const BoardPos diff = _pos - _playerPos;
+    auto spritePos = _sprite.camera()->position();
+    spritePos += bn::fixed_point{(s32)diff.x * consts::DUNGEON_META_TILE_SIZE.width(),
+                                 (s32)diff.y * consts::DUNGEON_META_TILE_SIZE.height()};
+    _sprite.set_position(spritePos);
 }
 
 } // namespace mp::game::item
@@ -8,40 +8,139 @@
 
 #include "game/item/ItemUse.hpp"
 
+#include "bn_assert.h"
+#include "bn_camera_ptr.h"
+#include "bn_sprite_item.h"
+
+#include "constants.hpp"
 #include "game/Hud.hpp"
+#include "game/item/ItemInfo.hpp"
 
 namespace mp::game::item
 {
 
+namespace
+{
+constexpr s32 TOSS_FRAMES_PER_TILE = 3;
+} // namespace
+
 ItemUse::ItemUse(Hud& hud) : _hud(hud)
 {
 }
 
+void ItemUse::update()
+{
+    if (_tossAction)
+    {
+        _tossAction->update();
+        if (_tossAction->done())
+            _tossAction.reset();
+    }
+}
+
 bool ItemUse::isOngoing() const
 {
-    // TODO: Return `true` when item use/toss animation is ongoing
-    return false;
+    // TODO: Also return `true` while the item use animation is ongoing, which is not implemented yet
+    return _tossAction.has_value();
 }
 
-bool ItemUse::hasInventoryItem() const
+bool ItemUse::hasSelectedItem() const
 {
-    return _inventoryItem.has_value();
+    return !_bag.empty();
 }
 
-auto ItemUse::getInventoryItem() -> bn::optional<Item>&
+bool ItemUse::isBagFull() const
 {
-    return _inventoryItem;
+    return _bag.full();
 }
 
-auto ItemUse::getInventoryItem() const -> const bn::optional<Item>&
+s32 ItemUse::getBagCount() const
 {
-    return _inventoryItem;
+    return _bag.size();
+}
+
+auto ItemUse::getSelectedItem() const -> const ItemRecord&
+{
+    BN_ASSERT(hasSelectedItem(), "Bag is empty");
+
+    return _bag[_selectedIdx];
 }
 
-void ItemUse::setInventoryItem(Item&& item)
+auto ItemUse::getSelectedItemInfo() const -> const ItemInfo&
 {
-    _hud.setInventory(item.getItemInfo());
-    _inventoryItem.emplace(bn::move(item));
+    return ItemInfo::fromKind(getSelectedItem().kind);
+}
+
+void ItemUse::addItem(const ItemRecord& record)
+{
+    BN_ASSERT(!isBagFull(), "Bag is full (", BAG_CAPACITY, ")");
+
+    _bag.push_back(record);
+    if (_bag.size() == 1)
+    {
+        _selectedIdx = 0;
+        _refreshSelectedItem();
+    }
+}
+
+void ItemUse::selectNextItem()
+{
+    if (_bag.size() <= 1)
+        return;
+
+    _selectedIdx = (_selectedIdx + 1) % _bag.size();
+    _refreshSelectedItem();
+}
+
+void ItemUse::replaceSelectedItem(const ItemRecord& record)
+{
+    BN_ASSERT(hasSelectedItem(), "Bag is empty");
+
+    _bag[_selectedIdx] = record;
+    _refreshSelectedItem();
+}
+
+auto ItemUse::releaseSelectedItem() -> ItemRecord
+{
+    BN_ASSERT(hasSelectedItem(), "Bag is empty");
+
+    const ItemRecord record = _bag[_selectedIdx];
+    _bag.erase(_bag.begin() + _selectedIdx);
+    if (_selectedIdx >= _bag.size())
+        _selectedIdx = 0;
+
+    _refreshSelectedItem();
+    return record;
+}
+
+void ItemUse::startTossAnimation(const Item& tossed, const bn::camera_ptr& camera, s32 tiles)
+{
+    BN_ASSERT(tiles > 0, "Invalid tiles(", tiles, ")");
+
+    bn::sprite_ptr sprite = tossed.getSprite();
+    const bn::fixed_point destination = sprite.position();
+
+    // camera is centered on the player.
+    sprite.set_position(camera.position());
+    _tossAction = bn::sprite_move_to_action(sprite, tiles * TOSS_FRAMES_PER_TILE, destination);
+}
+
+void ItemUse::_refreshSelectedItem()
+{
+    if (!hasSelectedItem())
+    {
+        _selectedSprite.reset();
+        _hud.clearInventory();
+        return;
+    }
+
+    const ItemInfo& info = getSelectedItemInfo();
+    _hud.setInventory(info);
+
+    bn::sprite_ptr sprite = info.spriteItem.create_sprite(consts::INVENTORY_POS, info.graphicsIndex);
+    sprite.set_bg_priority(consts::UI_BG_PRIORITY);
+    sprite.set_z_order(consts::ITEM_Z_ORDER);
+    _selectedSprite = bn::move(sprite);
 }
 
 } // namespace mp::game::item
@@ -11,19 +11,21 @@
 #include "iso_bn_random.h"
 
 #include "game/Dungeon.hpp"
+#include "game/item/ItemRecord.hpp"
+#include "game/item/ItemUse.hpp"
 #include "game/mob/Player.hpp"
 
 namespace mp::game::item::ability
 {
 
-void BananaAbility::use(mob::Player& user, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng) const
+void useBanana(mob::Player& user, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng)
 {
     user.getBelly().addCurrentBelly(50);
 
     // TODO: Call itemUse's start animation
 
     // Change item to banana peel
-    itemUse.setInventoryItem(Item(ItemKind::BANANA_PEEL, user));
+    itemUse.replaceSelectedItem(ItemRecord{ItemKind::BANANA_PEEL});
 }
 
 } // namespace mp::game::item::ability
@@ -8,12 +8,22 @@
 
 #include "game/item/ability/BananaPeelAbility.hpp"
 
+#include "game/mob/MonsterTable.hpp"
+#include "game/mob/StatusEffects.hpp"
+
 namespace mp::game::item::ability
 {
 
-void BananaPeelAbility::stepOn(mob::Monster& mob, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng) const
+namespace
+{
+constexpr u8 SLIP_TURNS = 3;
+} // namespace
+
+void stepOnBananaPeel(mob::MonsterTable& monsters, s32 monsterIndex, ItemUse& itemUse, Dungeon& dungeon,
+                      iso_bn::random& rng)
 {
-    // TODO: Set mob to a slipped state; unable to move for x turns.
+    // slipped monster is unable to act for a few turns.
+    monsters.getStatuses()[monsterIndex].add(mob::StatusEffectKind::SLIP, SLIP_TURNS);
 }
 
 } // namespace mp::game::item::ability
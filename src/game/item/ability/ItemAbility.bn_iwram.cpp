@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/item/ability/ItemAbility.hpp"
+
+#include "bn_assert.h"
+
+#include "game/item/ability/BananaAbility.hpp"
+#include "game/item/ability/BananaPeelAbility.hpp"
+
+// Abilities are dispatched for every item use & every monster step, so it runs from IWRAM as ARM code.
+// The table itself stays in ROM.
+
+namespace mp::game::item::ability
+{
+
+namespace
+{
+
+constexpr ItemAbility _abilities[] = {
+    {ItemKind::BANANA, useBanana, stepOnNothing},
+    {ItemKind::BANANA_PEEL, useNothing, stepOnBananaPeel},
+};
+
+static_assert(sizeof(_abilities) / sizeof(_abilities[0]) == ItemKind::TOTAL_ITEMS,
+              "Every ItemKind should have its ability");
+
+constexpr bool _isIndexedByKind()
+{
+    for (s32 i = 0; i < ItemKind::TOTAL_ITEMS; ++i)
+        if (_abilities[i].kind != i)
+            return false;
+    return true;
+}
+
+static_assert(_isIndexedByKind(), "Abilities should be in the order of ItemKind");
+
+} // namespace
+
+auto fromKind(ItemKind kind) -> const ItemAbility&
+{
+    BN_ASSERT(0 <= kind && kind < ItemKind::TOTAL_ITEMS, "Invalid kind(", kind, ")");
+
+    return _abilities[kind];
+}
+
+void use(ItemKind kind, mob::Player& user, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng)
+{
+    fromKind(kind).use(user, itemUse, dungeon, rng);
+}
+
+void stepOn(ItemKind kind, mob::MonsterTable& monsters, s32 monsterIndex, ItemUse& itemUse, Dungeon& dungeon,
+            iso_bn::random& rng)
+{
+    fromKind(kind).stepOn(monsters, monsterIndex, itemUse, dungeon, rng);
+}
+
+void stepOnAll(bn::span<const StepOnHit> hits, mob::MonsterTable& monsters, ItemUse& itemUse, Dungeon& dungeon,
+               iso_bn::random& rng)
+{
+    for (const StepOnHit& hit : hits)
+        fromKind(hit.itemKind).stepOn(monsters, hit.monsterIndex, itemUse, dungeon, rng);
+}
+
+} // namespace mp::game::item::ability
@@ -10,18 +10,16 @@
 
 #include "bn_assert.h"
 
-#include "Settings.hpp"
-#include "game/item/ItemInfo.hpp"
-
 namespace mp::game::item::ability
 {
 
-void ItemAbility::use(mob::Player& user, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng) const
+void useNothing(mob::Player& user, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng)
 {
-    BN_ERROR("{", ItemInfo::fromKind(getItemKind()).name[Settings::ENGLISH], "}::use() not overrided!");
+    BN_ERROR("This item can't be used");
 }
 
-void ItemAbility::stepOn(mob::Monster& mob, ItemUse& itemUse, Dungeon& dungeon, iso_bn::random& rng) const
+void stepOnNothing(mob::MonsterTable& monsters, s32 monsterIndex, ItemUse& itemUse, Dungeon& dungeon,
+                   iso_bn::random& rng)
 {
     // default: Nothing happens.
 }
@@ -57,6 +57,11 @@ void Monster::setBoardPos(const BoardPos& pos)
     setBoardPos(pos.x, pos.y);
 }
 
+Direction9 Monster::getDirection() const
+{
+    return _animation.getDirection();
+}
+
 void Monster::_act(const MonsterAction& action)
 {
     switch (action.getType())
@@ -9,7 +9,6 @@
 #include "game/mob/MonsterAnimation.hpp"
 
 #include "bn_camera_ptr.h"
-#include "bn_log.h"
 
 #include "constants.hpp"
 #include "game/Dungeon.hpp"
@@ -27,7 +26,7 @@ MonsterAnimation::MonsterAnimation(const MonsterInfo& mobInfo, const bn::camera_
 
 void MonsterAnimation::update(const Dungeon& dungeon)
 {
-    _updateMoveAction();
+    _updateMoveAction(dungeon);
     _updateAnimation(dungeon);
 }
 
@@ -45,7 +44,21 @@ void MonsterAnimation::startActions(Type animType, Direction9 direction)
 {
     _startAnimation(animType, direction);
     if (animType == Type::WALK)
-        _startMoveAction(direction);
+        _pendingMoveDiff += convertDir9ToPos(direction);
+}
+
+void MonsterAnimation::placeAt(const BoardPos& pos, const BoardPos& playerPos)
+{
+    const BoardPos diff = pos - playerPos;
+    auto spritePos = _sprite.camera()->position();
+    spritePos += bn::fixed_point{(s32)diff.x * consts::DUNGEON_META_TILE_SIZE.width(),
+                                 (s32)diff.y * consts::DUNGEON_META_TILE_SIZE.height()};
+    _sprite.set_position(spritePos);
+}
+
+Direction9 MonsterAnimation::getDirection() const
+{
+    return _direction;
 }
 
 void MonsterAnimation::_initGraphics(const bn::camera_ptr& camera)
@@ -80,14 +93,17 @@ void MonsterAnimation::_updateAnimation(const Dungeon& dungeon)
     }
 }
 
-void MonsterAnimation::_updateMoveAction()
+void MonsterAnimation::_updateMoveAction(const Dungeon& dungeon)
 {
+    if (!(_pendingMoveDiff == BoardPos{0, 0}))
+        _startMoveAction(dungeon.getMoveFrames());
+
+    // reset on the frame it's done, as the next move can start on the very next frame.
     if (_moveAction)
     {
+        _moveAction->update();
         if (_moveAction->done())
             _moveAction.reset();
-        else
-            _moveAction->update();
     }
 }
 
@@ -106,16 +122,16 @@ void MonsterAnimation::_startAnimation(Type animType, Direction9 direction)
     _animateAction = _getAnimation(animType, direction);
 }
 
-void MonsterAnimation::_startMoveAction(Direction9 direction)
+void MonsterAnimation::_startMoveAction(s32 moveFrames)
 {
-    if (_moveAction)
-        BN_LOG("_moveAction assigned again before destroying last _moveAction.");
-
     constexpr auto TILE_SIZE = consts::DUNGEON_META_TILE_SIZE;
 
-    auto diff = convertDir9ToPos(direction);
-    bn::fixed_point destination = {_sprite.x() + diff.x * TILE_SIZE.width(), _sprite.y() + diff.y * TILE_SIZE.height()};
-    _moveAction = bn::sprite_move_to_action(_sprite, consts::ACTOR_MOVE_FRAMES, destination);
+    // continue from where the last move would end, so that the sprite never lags behind the board position.
+    const bn::fixed_point from = _moveAction ? _moveAction->final_position() : _sprite.position();
+    const bn::fixed_point destination = {from.x() + _pendingMoveDiff.x * TILE_SIZE.width(),
+                                         from.y() + _pendingMoveDiff.y * TILE_SIZE.height()};
+    _moveAction = bn::sprite_move_to_action(_sprite, moveFrames, destination);
+    _pendingMoveDiff = {0, 0};
 }
 
 auto MonsterAnimation::_getAnimation(Type animType, Direction9 direction)
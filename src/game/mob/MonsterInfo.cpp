@@ -11,29 +11,17 @@
 #include "bn_assert.h"
 
 #include "game/mob/MonsterSpecies.hpp"
-#include "game/mob/ai/AI.hpp"
 #include "typedefs.hpp"
 
-#include "bn_sprite_items_spr_lemmas.h"
-#include "bn_sprite_items_spr_missing_no.h"
+#include "monster_infos.h"
 
 namespace mp::game::mob
 {
 
-namespace
-{
-
-constexpr MonsterInfo _monsterInfos[TOTAL_SPECIES] = {
-    MonsterInfo(MonsterSpecies::PLAYER, bn::sprite_items::spr_lemmas),
-    MonsterInfo(MonsterSpecies::LEMMAS, bn::sprite_items::spr_lemmas),
-};
-
-} // namespace
-
 auto MonsterInfo::fromSpecies(MonsterSpecies species) -> const MonsterInfo&
 {
     BN_ASSERT((s32)species < TOTAL_SPECIES, "species(", (s32)species, ") OOB");
-    return _monsterInfos[(s32)species];
+    return data::MONSTER_INFOS[(s32)species];
 }
 
 } // namespace mp::game::mob
@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/mob/MonsterTable.hpp"
+
+#include "bn_assert.h"
+#include "bn_camera_ptr.h"
+
+#include "game/mob/MonsterAction.hpp"
+#include "game/mob/MonsterInfo.hpp"
+#include "game/mob/MonsterSpecies.hpp"
+
+namespace mp::game::mob
+{
+
+MonsterTable::MonsterTable()
+{
+    _generations.fill(0);
+    clear();
+}
+
+void MonsterTable::update(const Dungeon& dungeon)
+{
+    for (const u8 slot : _slots)
+        _animations[slot]->update(dungeon);
+}
+
+auto MonsterTable::add(MonsterSpecies species, const BoardPos& pos, const BoardPos& playerPos,
+                       const bn::camera_ptr& camera) -> Handle
+{
+    BN_ASSERT(!full(), "MonsterTable is full (", MAX_COUNT, ")");
+
+    const MonsterInfo& info = MonsterInfo::fromSpecies(species);
+
+    const u8 slot = _freeSlots.back();
+    _freeSlots.pop_back();
+
+    _indexOfSlots[slot] = (s8)_slots.size();
+    _positions.push_back(pos);
+    _species.push_back(species);
+    _hps.push_back(info.maxHp);
+    _aiStates.push_back(ai::AIState::SLEEP);
+    _statuses.emplace_back();
+    _slots.push_back(slot);
+
+    MonsterAnimation& animation = _animations[slot].emplace(info, camera);
+    animation.placeAt(pos, playerPos);
+
+    return Handle{slot, _generations[slot]};
+}
+
+void MonsterTable::remove(Handle handle)
+{
+    BN_ASSERT(contains(handle), "Invalid handle (slot=", handle.slot, ", gen=", handle.generation, ")");
+
+    removeAt(_indexOfSlots[handle.slot]);
+}
+
+void MonsterTable::removeAt(s32 index)
+{
+    BN_ASSERT(0 <= index && index < size(), "Invalid index(", index, ")");
+
+    const u8 slot = _slots[index];
+    const s32 lastIndex = size() - 1;
+
+    if (index != lastIndex)
+    {
+        _positions[index] = _positions[lastIndex];
+        _species[index] = _species[lastIndex];
+        _hps[index] = _hps[lastIndex];
+        _aiStates[index] = _aiStates[lastIndex];
+        _statuses[index] = _statuses[lastIndex];
+        _slots[index] = _slots[lastIndex];
+        _indexOfSlots[_slots[index]] = (s8)index;
+    }
+
+    _positions.pop_back();
+    _species.pop_back();
+    _hps.pop_back();
+    _aiStates.pop_back();
+    _statuses.pop_back();
+    _slots.pop_back();
+
+    _animations[slot].reset();
+    _indexOfSlots[slot] = -1;
+    ++_generations[slot];
+    _freeSlots.push_back(slot);
+}
+
+void MonsterTable::clear()
+{
+    _positions.clear();
+    _species.clear();
+    _hps.clear();
+    _aiStates.clear();
+    _statuses.clear();
+    _slots.clear();
+
+    _freeSlots.clear();
+    for (s32 slot = MAX_COUNT - 1; slot >= 0; --slot)
+    {
+        if (_animations[slot])
+        {
+            _animations[slot].reset();
+            ++_generations[slot];
+        }
+        _indexOfSlots[slot] = -1;
+        _freeSlots.push_back((u8)slot);
+    }
+}
+
+bool MonsterTable::contains(Handle handle) const
+{
+    return handle.slot < MAX_COUNT && _indexOfSlots[handle.slot] >= 0 &&
+           _generations[handle.slot] == handle.generation;
+}
+
+s32 MonsterTable::size() const
+{
+    return _slots.size();
+}
+
+bool MonsterTable::empty() const
+{
+    return _slots.empty();
+}
+
+bool MonsterTable::full() const
+{
+    return _slots.full();
+}
+
+s32 MonsterTable::getIndex(Handle handle) const
+{
+    BN_ASSERT(contains(handle), "Invalid handle (slot=", handle.slot, ", gen=", handle.generation, ")");
+
+    return _indexOfSlots[handle.slot];
+}
+
+auto MonsterTable::getHandle(s32 index) const -> Handle
+{
+    BN_ASSERT(0 <= index && index < size(), "Invalid index(", index, ")");
+
+    const u8 slot = _slots[index];
+    return Handle{slot, _generations[slot]};
+}
+
+s32 MonsterTable::getIndexOfSlot(u8 slot) const
+{
+    BN_ASSERT(slot < MAX_COUNT && _indexOfSlots[slot] >= 0, "Invalid slot(", slot, ")");
+
+    return _indexOfSlots[slot];
+}
+
+s32 MonsterTable::findIndexAt(const BoardPos& pos) const
+{
+    for (s32 i = 0; i < _positions.size(); ++i)
+        if (_positions[i] == pos)
+            return i;
+
+    return -1;
+}
+
+void MonsterTable::act(s32 index, const MonsterAction& action)
+{
+    BN_ASSERT(0 <= index && index < size(), "Invalid index(", index, ")");
+
+    MonsterAnimation& animation = getAnimation(index);
+
+    switch (action.getType())
+    {
+        using Action = mob::MonsterAction::Type;
+        using AnimType = MonsterAnimation::Type;
+    case Action::CHANGE_DIRECTION:
+        animation.startActions(AnimType::IDLE, action.getDirection());
+        break;
+    case Action::MOVE:
+        animation.startActions(AnimType::WALK, action.getDirection());
+        _positions[index] += action.getDirectionPos();
+        break;
+    case Action::DO_NOTHING:
+        break;
+    default:
+        BN_ERROR("Invalid MonsterAction::Type(", (s32)action.getType(), ")");
+    }
+}
+
+void MonsterTable::setVisible(bool isVisible)
+{
+    for (const u8 slot : _slots)
+        _animations[slot]->setVisible(isVisible);
+}
+
+auto MonsterTable::getPositions() const -> bn::span<const BoardPos>
+{
+    return bn::span<const BoardPos>(_positions.data(), _positions.size());
+}
+
+auto MonsterTable::getSpecies() const -> bn::span<const MonsterSpecies>
+{
+    return bn::span<const MonsterSpecies>(_species.data(), _species.size());
+}
+
+auto MonsterTable::getHps() const -> bn::span<const s16>
+{
+    return bn::span<const s16>(_hps.data(), _hps.size());
+}
+
+auto MonsterTable::getHps() -> bn::span<s16>
+{
+    return bn::span<s16>(_hps.data(), _hps.size());
+}
+
+auto MonsterTable::getAIStates() const -> bn::span<const ai::AIState>
+{
+    return bn::span<const ai::AIState>(_aiStates.data(), _aiStates.size());
+}
+
+auto MonsterTable::getAIStates() -> bn::span<ai::AIState>
+{
+    return bn::span<ai::AIState>(_aiStates.data(), _aiStates.size());
+}
+
+auto MonsterTable::getStatuses() const -> bn::span<const StatusEffects>
+{
+    return bn::span<const StatusEffects>(_statuses.data(), _statuses.size());
+}
+
+auto MonsterTable::getStatuses() -> bn::span<StatusEffects>
+{
+    return bn::span<StatusEffects>(_statuses.data(), _statuses.size());
+}
+
+auto MonsterTable::getAnimation(s32 index) -> MonsterAnimation&
+{
+    BN_ASSERT(0 <= index && index < size(), "Invalid index(", index, ")");
+
+    return *_animations[_slots[index]];
+}
+
+} // namespace mp::game::mob
@@ -8,6 +8,7 @@
 
 #include "game/mob/Player.hpp"
 
+#include "game/mob/MonsterInfo.hpp"
 #include "game/mob/MonsterSpecies.hpp"
 
 namespace mp::game::mob
@@ -39,4 +40,31 @@ PlayerBelly& Player::getBelly()
     return _belly;
 }
 
+auto Player::getStatuses() -> StatusEffects&
+{
+    return _statuses;
+}
+
+auto Player::getStatuses() const -> const StatusEffects&
+{
+    return _statuses;
+}
+
+void Player::updateHungerStatus()
+{
+    // hunger lasts while the belly is low, rather than for some turns.
+    if (_belly.isHungry())
+        _statuses.add(StatusEffectKind::HUNGER, StatusEffects::ENDLESS_TURNS);
+    else
+        _statuses.remove(StatusEffectKind::HUNGER);
+}
+
+auto Player::getSpeed() const -> MonsterSpeed
+{
+    if (_statuses.has(StatusEffectKind::HUNGER))
+        return MonsterSpeed::SLOW;
+
+    return MonsterInfo::fromSpecies(MonsterSpecies::PLAYER).speed;
+}
+
 } // namespace mp::game::mob
@@ -39,6 +39,11 @@ bool PlayerBelly::isStarveToDeath() const
     return _currentBelly <= 0;
 }
 
+bool PlayerBelly::isHungry() const
+{
+    return _currentBelly * 100 <= _maxBelly * HUNGRY_PERCENT;
+}
+
 s32 PlayerBelly::getMaxBelly() const
 {
     return _maxBelly;
@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/mob/StatusEffects.hpp"
+
+#include "bn_assert.h"
+
+namespace mp::game::mob
+{
+
+namespace
+{
+
+constexpr u8 _maskOf(StatusEffectKind kind)
+{
+    return (u8)(1 << kind);
+}
+
+constexpr u8 INCAPACITATED_MASK = _maskOf(StatusEffectKind::SLIP) | _maskOf(StatusEffectKind::SLEEP);
+constexpr u8 ALL_MASK = (u8)((1 << TOTAL_STATUS_EFFECTS) - 1);
+
+} // namespace
+
+void StatusEffects::add(StatusEffectKind kind, u8 turns)
+{
+    BN_ASSERT(0 <= kind && kind < TOTAL_STATUS_EFFECTS, "Invalid StatusEffectKind(", kind, ")");
+    BN_ASSERT(turns > 0, "turns(", turns, ") should be positive");
+
+    if (!has(kind) || _turns[kind] < turns)
+        _turns[kind] = turns;
+    _flags |= _maskOf(kind);
+}
+
+void StatusEffects::remove(StatusEffectKind kind)
+{
+    BN_ASSERT(0 <= kind && kind < TOTAL_STATUS_EFFECTS, "Invalid StatusEffectKind(", kind, ")");
+
+    _flags &= ~_maskOf(kind);
+    _turns[kind] = 0;
+}
+
+void StatusEffects::clear()
+{
+    _flags = 0;
+    _turns.fill(0);
+}
+
+bool StatusEffects::has(StatusEffectKind kind) const
+{
+    return _flags & _maskOf(kind);
+}
+
+bool StatusEffects::any() const
+{
+    return _flags != 0;
+}
+
+u8 StatusEffects::getTurns(StatusEffectKind kind) const
+{
+    BN_ASSERT(0 <= kind && kind < TOTAL_STATUS_EFFECTS, "Invalid StatusEffectKind(", kind, ")");
+
+    return _turns[kind];
+}
+
+bool StatusEffects::isIncapacitated() const
+{
+    return _flags & INCAPACITATED_MASK;
+}
+
+void StatusEffects::tick()
+{
+    // most actors have no effect at all.
+    if (_flags == 0)
+        return;
+
+    for (s32 kind = 0; kind < TOTAL_STATUS_EFFECTS; ++kind)
+    {
+        const u8 mask = _maskOf((StatusEffectKind)kind);
+        if ((_flags & mask) && _turns[kind] != ENDLESS_TURNS && --_turns[kind] == 0)
+            _flags &= ~mask;
+    }
+}
+
+void StatusEffects::tickAll(bn::span<StatusEffects> statuses)
+{
+    for (StatusEffects& status : statuses)
+        status.tick();
+}
+
+auto StatusEffects::serialize() const -> Serialized
+{
+    Serialized result;
+    result[0] = _flags;
+    for (s32 kind = 0; kind < TOTAL_STATUS_EFFECTS; ++kind)
+        result[1 + kind] = _turns[kind];
+    return result;
+}
+
+auto StatusEffects::deserialize(const Serialized& data) -> StatusEffects
+{
+    BN_ASSERT(!(data[0] & ~ALL_MASK), "Invalid status effect flags(", data[0], ")");
+
+    StatusEffects result;
+    result._flags = data[0];
+    for (s32 kind = 0; kind < TOTAL_STATUS_EFFECTS; ++kind)
+    {
+        const bool isActive = result._flags & _maskOf((StatusEffectKind)kind);
+        BN_ASSERT(isActive == (data[1 + kind] != 0), "Invalid turns(", data[1 + kind], ") of status effect(", kind,
+                  ")");
+        result._turns[kind] = data[1 + kind];
+    }
+    return result;
+}
+
+} // namespace mp::game::mob
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+ *
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * See LICENSE file for details.
+ */
+
+#include "game/mob/ai/AI.hpp"
+
+#include "bn_assert.h"
+#include "bn_config_profiler.h"
+#include "bn_profiler.h"
+#include "iso_bn_random.h"
+
+#include "game/DungeonFloor.hpp"
+#include "game/mob/MonsterInfo.hpp"
+#include "game/mob/MonsterSpecies.hpp"
+#include "game/mob/MonsterTable.hpp"
+
+namespace mp::game::mob::ai
+{
+
+namespace
+{
+
+s32 _sign(s32 value)
+{
+    return (value > 0) - (value < 0);
+}
+
+s32 _abs(s32 value)
+{
+    return (value < 0) ? -value : value;
+}
+
+// Chebyshev distance, as monsters can move diagonally.
+s32 _distance(const BoardPos& a, const BoardPos& b)
+{
+    const BoardPos diff = a - b;
+    const s32 dx = _abs(diff.x), dy = _abs(diff.y);
+    return (dx > dy) ? dx : dy;
+}
+
+} // namespace
+
+Direction9 AI::think(AIState& state, const Senses& senses, iso_bn::random& rng) const
+{
+    for (const Transition& transition : _transitions)
+    {
+        if (transition.from == state && _isMet(transition.condition, senses, rng))
+        {
+            state = transition.to;
+            break;
+        }
+    }
+
+    const BoardPos toPlayer = senses.playerPos - senses.pos;
+
+    switch (state)
+    {
+        using State = AIState;
+    case State::SLEEP:
+        return Direction9::NONE;
+    case State::WANDER:
+        return (Direction9)(rng.get_int(8) + 1);
+    case State::CHASE:
+        return convertPosToDir9({(s8)_sign(toPlayer.x), (s8)_sign(toPlayer.y)});
+    case State::FLEE:
+        return convertPosToDir9({(s8)-_sign(toPlayer.x), (s8)-_sign(toPlayer.y)});
+    default:
+        BN_ERROR("Invalid AIState(", (s32)state, ")");
+    }
+    return Direction9::NONE;
+}
+
+bool AI::_isMet(Condition condition, const Senses& senses, iso_bn::random& rng) const
+{
+    switch (condition)
+    {
+        using Cond = Condition;
+    case Cond::ALWAYS:
+        return true;
+    case Cond::SEE_PLAYER:
+        return _distance(senses.pos, senses.playerPos) <= _sightRange;
+    case Cond::LOST_PLAYER:
+        return _distance(senses.pos, senses.playerPos) > _sightRange;
+    case Cond::LOW_HP:
+        return senses.hp * 100 <= senses.maxHp * _lowHpPercent;
+    case Cond::RANDOM:
+        return rng.get_int(8) == 0;
+    default:
+        BN_ERROR("Invalid Condition(", (s32)condition, ")");
+    }
+    return false;
+}
+
+#ifdef MP_DEBUG
+void AI::benchmarkThink(iso_bn::random& rng)
+{
+    constexpr s32 BENCHMARK_COUNT = 16;
+    constexpr s32 MONSTERS_COUNT = MonsterTable::MAX_COUNT;
+
+    const AI& ai = MonsterInfo::fromSpecies(MonsterSpecies::LEMMAS).ai;
+
+    Senses senses[MONSTERS_COUNT];
+    AIState states[MONSTERS_COUNT];
+    for (s32 i = 0; i < MONSTERS_COUNT; ++i)
+    {
+        senses[i] = {{(s8)rng.get_int(DungeonFloor::COLUMNS), (s8)rng.get_int(DungeonFloor::ROWS)},
+                     {DungeonFloor::COLUMNS / 2, DungeonFloor::ROWS / 2},
+                     (s16)(rng.get_int(8) + 1),
+                     8};
+        states[i] = (AIState)rng.get_int((s32)AIState::TOTAL_STATES);
+    }
+
+    for (s32 count = 0; count < BENCHMARK_COUNT; ++count)
+    {
+        BN_PROFILER_START("ai_think_all_monsters");
+        for (s32 i = 0; i < MONSTERS_COUNT; ++i)
+            ai.think(states[i], senses[i], rng);
+        BN_PROFILER_STOP();
+    }
+}
+#endif
+
+} // namespace mp::game::mob::ai
@@ -16,6 +16,7 @@
 
 #include "TextGen.hpp"
 #include "debug/DebugView.hpp"
+#include "debug/StackPaint.hpp"
 #include "scene/Game.hpp"
 
 using namespace mp;
@@ -23,6 +24,9 @@ using namespace mp;
 int main()
 {
     bn::core::init();
+#ifdef MP_DEBUG
+    debug::StackPaint::paint();
+#endif
     // TEST
     bn::bg_palettes::set_transparent_color(bn::color(16, 16, 16));
 
@@ -67,7 +71,7 @@ int main()
             }
         }
 #ifdef MP_DEBUG
-        debugView.update();
+        debugView.update(scene.get());
 #endif
         bn::core::update();
     }
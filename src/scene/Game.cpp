@@ -13,7 +13,13 @@
 namespace mp::scene
 {
 
-Game::Game(iso_bn::random& rng, TextGen& textGen, Settings& settings) : _rng(rng), _dungeon(rng, textGen, settings)
+namespace
+{
+constexpr s32 ARENA_BYTES = 96 * 1024;
+} // namespace
+
+Game::Game(iso_bn::random& rng, TextGen& textGen, Settings& settings)
+    : _rng(rng), _arena(ARENA_BYTES, "game"), _dungeon(_arena.create<game::Dungeon>(_arena, rng, textGen, settings))
 {
 }
 
@@ -24,4 +30,9 @@ bn::optional<SceneType> Game::update()
     return nextScene;
 }
 
+auto Game::getArena() const -> const Arena*
+{
+    return &_arena;
+}
+
 } // namespace mp::scene
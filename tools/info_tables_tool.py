@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+# See LICENSE file for details.
+
+"""
+Generates `item_infos.h` and `monster_infos.h` from the JSON definitions in `defs/`.
+
+Definitions are cross-checked against the enums in `include/` and the sprites in `graphics/` while generating,
+and the generated headers static_assert that the tables are in the order of their enums.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+ITEMS_HEADER_NAME = "item_infos.h"
+MONSTERS_HEADER_NAME = "monster_infos.h"
+
+ITEM_KIND_PATH = "game/item/ItemKind.hpp"
+MONSTER_SPECIES_PATH = "game/mob/MonsterSpecies.hpp"
+MONSTER_SPEED_PATH = "game/mob/MonsterSpeed.hpp"
+AI_STATE_PATH = "game/mob/ai/AIState.hpp"
+AI_PATH = "game/mob/ai/AI.hpp"
+
+# should match the assert in `ItemInfo`'s constructor.
+TOSS_DISTANCE_MAX = 4
+
+# column limit of the C++ sources, as in `.clang-format`.
+LINE_LENGTH_MAX = 120
+
+
+class DefinitionError(ValueError):
+    pass
+
+
+def strip_comments(source):
+    source = re.sub(r"//[^\n]*", "", source)
+    return re.sub(r"/\*.*?\*/", "", source, flags=re.DOTALL)
+
+
+def read_enum(include_dir, header_path, enum_name):
+    path = os.path.join(include_dir, header_path)
+    with open(path, encoding="utf-8") as f:
+        source = strip_comments(f.read())
+
+    enum_body = re.search(r"enum\s+(?:class\s+)?" + enum_name + r"\s*(?::\s*\w+\s*)?{([^}]*)}", source)
+    if enum_body is None:
+        raise DefinitionError(f"`enum {enum_name}` not found in {path}")
+
+    members = []
+    for member in enum_body.group(1).split(","):
+        name = member.split("=")[0].strip()
+        if name.startswith("TOTAL_"):
+            break
+        if name:
+            members.append(name)
+    return members
+
+
+def count_sprite_frames(graphics_dir, sprite):
+    json_path = os.path.join(graphics_dir, sprite + ".json")
+    bmp_path = os.path.join(graphics_dir, sprite + ".bmp")
+    if not os.path.isfile(json_path) or not os.path.isfile(bmp_path):
+        raise DefinitionError(f"sprite `{sprite}` not found in {graphics_dir}")
+
+    with open(json_path, encoding="utf-8") as f:
+        sprite_json = json.load(f)
+    if sprite_json.get("type") != "sprite":
+        raise DefinitionError(f"`{sprite}` is not a sprite")
+
+    with open(bmp_path, "rb") as f:
+        bmp_header = f.read(26)
+    width, height = struct.unpack("<ii", bmp_header[18:26])
+    frame_height = int(sprite_json.get("height", width))
+    return abs(height) // frame_height
+
+
+def check_order(definitions, key, enum_members, what):
+    names = [definition[key] for definition in definitions]
+    if names != enum_members:
+        raise DefinitionError(f"{what} should be defined once each, in the enum order {enum_members}, not {names}")
+
+
+def check_graphics_index(definition, name, graphics_dir):
+    frames = count_sprite_frames(graphics_dir, definition["sprite"])
+    graphics_index = definition.get("graphics_index", 0)
+    if not 0 <= graphics_index < frames:
+        raise DefinitionError(f"{name}: graphics_index {graphics_index} is out of `{definition['sprite']}` "
+                              f"({frames} frames)")
+
+
+def sprite_includes(definitions):
+    sprites = sorted({definition["sprite"] for definition in definitions})
+    return "\n".join(f'#include "bn_sprite_items_{sprite}.h"' for sprite in sprites)
+
+
+def cpp_bool(value):
+    return "true" if value else "false"
+
+
+def generate_items(items_path, include_dir, graphics_dir):
+    with open(items_path, encoding="utf-8") as f:
+        items = json.load(f)["items"]
+
+    kinds = read_enum(include_dir, ITEM_KIND_PATH, "ItemKind")
+    check_order(items, "kind", kinds, "items")
+
+    entries = []
+    for item in items:
+        kind = item["kind"]
+        check_graphics_index(item, kind, graphics_dir)
+        toss_distance = item["toss_distance"]
+        if not 0 <= toss_distance <= TOSS_DISTANCE_MAX:
+            raise DefinitionError(f"{kind}: toss_distance {toss_distance} is out of [0..{TOSS_DISTANCE_MAX}]")
+
+        entries.append(f"    ItemInfo(ItemKind::{kind}, {cpp_bool(item['can_be_used'])}, {toss_distance}, "
+                       f"bn::sprite_items::{item['sprite']}, {item.get('graphics_index', 0)},\n"
+                       f"             texts::ITEM_NAME_AND_DESC[ItemKind::{kind}].first,\n"
+                       f"             texts::ITEM_NAME_AND_DESC[ItemKind::{kind}].second),")
+
+    body = "\n".join(entries)
+    return f"""// Generated by tools/info_tables_tool.py from {items_path}. DO NOT EDIT.
+
+#ifndef ITEM_INFOS_H
+#define ITEM_INFOS_H
+
+#include "game/item/ItemInfo.hpp"
+#include "game/item/ItemKind.hpp"
+#include "texts.hpp"
+
+{sprite_includes(items)}
+
+namespace mp::game::item::data
+{{
+
+inline constexpr ItemInfo ITEM_INFOS[] = {{
+{body}
+}};
+
+static_assert(sizeof(ITEM_INFOS) / sizeof(ITEM_INFOS[0]) == ItemKind::TOTAL_ITEMS);
+static_assert(texts::ITEM_NAME_AND_DESC.size() == ItemKind::TOTAL_ITEMS);
+
+constexpr bool isIndexedByKind()
+{{
+    for (int i = 0; i < ItemKind::TOTAL_ITEMS; ++i)
+        if (ITEM_INFOS[i].kind != i)
+            return false;
+    return true;
+}}
+
+static_assert(isIndexedByKind(), "ITEM_INFOS should be in the order of ItemKind");
+
+}} // namespace mp::game::item::data
+
+#endif
+"""
+
+
+def generate_monsters(monsters_path, include_dir, graphics_dir):
+    with open(monsters_path, encoding="utf-8") as f:
+        definitions = json.load(f)
+    ais = definitions["ais"]
+    monsters = definitions["monsters"]
+
+    species_list = read_enum(include_dir, MONSTER_SPECIES_PATH, "MonsterSpecies")
+    speeds = read_enum(include_dir, MONSTER_SPEED_PATH, "MonsterSpeed")
+    states = read_enum(include_dir, AI_STATE_PATH, "AIState")
+    conditions = read_enum(include_dir, AI_PATH, "Condition")
+    check_order(monsters, "species", species_list, "monsters")
+
+    ai_lines = []
+    for ai_name, ai in ais.items():
+        if not re.fullmatch(r"[a-z_][a-z0-9_]*", ai_name):
+            raise DefinitionError(f"AI name `{ai_name}` should be snake_case")
+
+        transitions = []
+        for transition in ai["transitions"]:
+            from_state, condition, to_state = transition
+            for state in (from_state, to_state):
+                if state not in states:
+                    raise DefinitionError(f"AI `{ai_name}`: unknown state `{state}`")
+            if condition not in conditions:
+                raise DefinitionError(f"AI `{ai_name}`: unknown condition `{condition}`")
+            transitions.append(f"    {{ai::AIState::{from_state}, ai::Condition::{condition}, "
+                               f"ai::AIState::{to_state}}},")
+
+        upper_name = ai_name.upper()
+        if transitions:
+            ai_lines.append(f"inline constexpr ai::Transition {upper_name}_AI_TRANSITIONS[] = {{")
+            ai_lines.extend(transitions)
+            ai_lines.append("};")
+            transitions_span = f"{upper_name}_AI_TRANSITIONS"
+        else:
+            transitions_span = "{}"
+        ai_lines.append(f"inline constexpr ai::AI {upper_name}_AI({transitions_span}, {ai['sight_range']}, "
+                        f"{ai['low_hp_percent']});")
+        ai_lines.append("")
+
+    entries = []
+    for monster in monsters:
+        species = monster["species"]
+        check_graphics_index(monster, species, graphics_dir)
+        if monster["speed"] not in speeds:
+            raise DefinitionError(f"{species}: unknown speed `{monster['speed']}`")
+        if monster["ai"] not in ais:
+            raise DefinitionError(f"{species}: unknown AI `{monster['ai']}`")
+        if not 0 < monster["max_hp"] <= 0x7FFF:
+            raise DefinitionError(f"{species}: max_hp {monster['max_hp']} is out of s16")
+
+        entry = (f"    MonsterInfo(MonsterSpecies::{species}, bn::sprite_items::{monster['sprite']}, "
+                 f"{monster['max_hp']}, MonsterSpeed::{monster['speed']}, {monster['ai'].upper()}_AI),")
+        if len(entry) > LINE_LENGTH_MAX:
+            entry = entry.replace("MonsterSpeed::" + monster["speed"] + ", ",
+                                  "MonsterSpeed::" + monster["speed"] + ",\n                ")
+        entries.append(entry)
+
+    ai_body = "\n".join(ai_lines)
+    body = "\n".join(entries)
+    return f"""// Generated by tools/info_tables_tool.py from {monsters_path}. DO NOT EDIT.
+
+#ifndef MONSTER_INFOS_H
+#define MONSTER_INFOS_H
+
+#include "game/mob/MonsterInfo.hpp"
+#include "game/mob/MonsterSpecies.hpp"
+#include "game/mob/MonsterSpeed.hpp"
+#include "game/mob/ai/AI.hpp"
+
+{sprite_includes(monsters)}
+
+namespace mp::game::mob::data
+{{
+
+{ai_body}
+inline constexpr MonsterInfo MONSTER_INFOS[] = {{
+{body}
+}};
+
+static_assert(sizeof(MONSTER_INFOS) / sizeof(MONSTER_INFOS[0]) == TOTAL_SPECIES);
+
+constexpr bool isIndexedBySpecies()
+{{
+    for (int i = 0; i < TOTAL_SPECIES; ++i)
+        if (MONSTER_INFOS[i].species != i)
+            return false;
+    return true;
+}}
+
+static_assert(isIndexedBySpecies(), "MONSTER_INFOS should be in the order of MonsterSpecies");
+
+}} // namespace mp::game::mob::data
+
+#endif
+"""
+
+
+def write_if_changed(build_dir, header_name, header):
+    header_path = os.path.join(build_dir, header_name)
+
+    # don't touch the header if it's unchanged, to avoid rebuilding everything.
+    if os.path.isfile(header_path):
+        with open(header_path, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+
+    with open(header_path, "w", encoding="utf-8") as f:
+        f.write(header)
+    print(f"{header_name} generated")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="constexpr info tables generator from JSON definitions")
+    parser.add_argument("--build", required=True, help="build folder path")
+    parser.add_argument("--items", required=True, help="item definitions JSON path")
+    parser.add_argument("--monsters", required=True, help="monster definitions JSON path")
+    parser.add_argument("--include", default="include", help="include folder path, to read the enums")
+    parser.add_argument("--graphics", default="graphics", help="graphics folder path, to check the sprites")
+    args = parser.parse_args()
+
+    items_header = generate_items(args.items, args.include, args.graphics)
+    monsters_header = generate_monsters(args.monsters, args.include, args.graphics)
+
+    os.makedirs(args.build, exist_ok=True)
+    write_if_changed(args.build, ITEMS_HEADER_NAME, items_header)
+    write_if_changed(args.build, MONSTERS_HEADER_NAME, monsters_header)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyError as ex:
+        sys.exit(f"info_tables_tool error: {ex} is missing in a definition")
+    except (OSError, ValueError) as ex:
+        sys.exit(f"info_tables_tool error: {ex}")
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+# See LICENSE file for details.
+
+"""
+Reports how much of the 32 KiB IWRAM is statically used by the ROM elf, and which game functions live there.
+
+Exits with an error if the static IWRAM usage exceeds the budget,
+so that the remaining IWRAM for the stack doesn't silently shrink.
+"""
+
+import argparse
+import subprocess
+import sys
+
+IWRAM_START = 0x03000000
+IWRAM_SIZE = 32 * 1024
+
+GAME_NAMESPACE = "mp::"
+
+
+def is_iwram(address):
+    return IWRAM_START <= address < IWRAM_START + IWRAM_SIZE
+
+
+def run(command):
+    return subprocess.run(command, check=True, capture_output=True, text=True).stdout
+
+
+def read_sections(size_tool, elf):
+    # `size -A` lines: section size addr
+    sections = []
+    for line in run([size_tool, "-A", elf]).splitlines():
+        columns = line.split()
+        if len(columns) != 3 or not columns[1].isdigit():
+            continue
+        name, size, address = columns[0], int(columns[1]), int(columns[2])
+        if size > 0 and is_iwram(address):
+            sections.append((name, size))
+    return sections
+
+
+def read_game_symbols(nm_tool, elf):
+    # `nm -C -S` lines: address size type name
+    symbols = []
+    for line in run([nm_tool, "-C", "-S", "--size-sort", elf]).splitlines():
+        columns = line.split(maxsplit=3)
+        if len(columns) != 4:
+            continue
+        address, size, sym_type, name = int(columns[0], 16), int(columns[1], 16), columns[2], columns[3]
+        if sym_type in "tT" and is_iwram(address) and name.startswith(GAME_NAMESPACE):
+            symbols.append((name, size))
+    return symbols
+
+
+def main():
+    parser = argparse.ArgumentParser(description="IWRAM usage report")
+    parser.add_argument("--elf", required=True, help="ROM elf path")
+    parser.add_argument("--tools-prefix", default="arm-none-eabi-", help="binutils prefix")
+    parser.add_argument("--budget", type=int, required=True, help="max bytes of static IWRAM usage")
+    args = parser.parse_args()
+
+    sections = read_sections(args.tools_prefix + "size", args.elf)
+    symbols = read_game_symbols(args.tools_prefix + "nm", args.elf)
+
+    total = sum(size for _, size in sections)
+
+    print("=== IWRAM sections ===")
+    for name, size in sections:
+        print(f"{size:8} {name}")
+
+    print("=== game code in IWRAM ===")
+    for name, size in sorted(symbols, key=lambda symbol: -symbol[1]):
+        print(f"{size:8} {name}")
+    print(f"{sum(size for _, size in symbols):8} total")
+
+    print("=== summary ===")
+    print(f"static IWRAM: {total} / {IWRAM_SIZE} bytes (budget {args.budget} bytes)")
+    print(f"left for the stack: {IWRAM_SIZE - total} bytes")
+
+    if total > args.budget:
+        sys.exit(f"iwram_report error: static IWRAM usage {total} bytes exceeds the budget {args.budget} bytes")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except (OSError, subprocess.CalledProcessError) as ex:
+        sys.exit(f"iwram_report error: {ex}")
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+# See LICENSE file for details.
+
+"""
+Reports the stack usage of every function, from the `*.su` files generated with `-fstack-usage`.
+
+Exits with an error if any function in the checked source folders exceeds the limit,
+so that big temporaries don't silently end up on the IWRAM stack.
+"""
+
+import argparse
+import glob
+import os
+import sys
+
+TOP_FUNCTIONS_COUNT = 20
+
+
+def read_stack_usages(build):
+    # `*.su` lines: path:line:column:function<TAB>bytes<TAB>qualifiers
+    usages = []
+    for su_path in glob.glob(os.path.join(build, "**", "*.su"), recursive=True):
+        with open(su_path, encoding="utf-8") as f:
+            for line in f:
+                columns = line.rstrip("\n").split("\t")
+                if len(columns) != 3:
+                    continue
+                location, size, qualifiers = columns
+                source, _, function = location.partition(":")
+                function = function.split(":", 2)[-1]
+                usages.append((os.path.normpath(source), function, int(size), qualifiers))
+    return usages
+
+
+def is_checked(source, checked_dirs):
+    source = source.replace(os.sep, "/")
+    return any(f"/{checked}/" in f"/{source}" for checked in checked_dirs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="stack usage report")
+    parser.add_argument("--build", required=True, help="build folder path, which has the `*.su` files")
+    parser.add_argument("--check", required=True, help="source folders to check the limit, separated by spaces")
+    parser.add_argument("--limit", type=int, required=True, help="max stack bytes of a single function")
+    args = parser.parse_args()
+
+    usages = read_stack_usages(args.build)
+    if not usages:
+        sys.exit(f"stack_report error: no `*.su` files in {args.build} (build with `-fstack-usage`)")
+
+    checked_dirs = [os.path.normpath(checked).replace(os.sep, "/") for checked in args.check.split()]
+
+    print(f"=== top {TOP_FUNCTIONS_COUNT} stack users ===")
+    for source, function, size, qualifiers in sorted(usages, key=lambda usage: -usage[2])[:TOP_FUNCTIONS_COUNT]:
+        print(f"{size:8} {function} ({qualifiers}) [{source}]")
+
+    over_limit = [usage for usage in usages if usage[2] > args.limit and is_checked(usage[0], checked_dirs)]
+
+    print("=== summary ===")
+    print(f"{len(usages)} functions, limit {args.limit} bytes for {' '.join(checked_dirs)}")
+
+    # `dynamic` stack usage can't be bounded at compile time, so it's reported as well.
+    for source, function, size, qualifiers in usages:
+        if "dynamic" in qualifiers and "bounded" not in qualifiers and is_checked(source, checked_dirs):
+            print(f"warning: unbounded dynamic stack usage in {function} [{source}]")
+
+    if over_limit:
+        for source, function, size, _ in over_limit:
+            print(f"{size:8} {function} [{source}]")
+        sys.exit(f"stack_report error: {len(over_limit)} functions exceed the stack limit {args.limit} bytes")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except (OSError, ValueError) as ex:
+        sys.exit(f"stack_report error: {ex}")
@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright (C) 2022  Guyeon Yu <copyrat90@gmail.com>
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+# See LICENSE file for details.
+
+"""
+Generates `texts_glyphs.h` from `texts.hpp`.
+
+Every `LangTexts` initializer in `texts.hpp` is re-encoded as runs of dense per-language glyph ids (`u8`),
+so that the runtime never has to decode UTF-8 to draw a text.
+Its string literals are the texts of each language, in the order of `enum Language`.
+Any string literal outside of a `LangTexts` initializer is an error, as its language can't be told.
+`{}` argument placeholders are encoded as a single `PLACEHOLDER_ID`.
+
+Per-language glyph VRAM needs are reported while generating.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HEADER_NAME = "texts_glyphs.h"
+
+SPACE_ID = 0
+PLACEHOLDER_ID = 255
+MAX_GLYPHS = PLACEHOLDER_ID
+
+TILE_BYTES = 32  # 8x8 4bpp
+
+STRING_PATTERN = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# `LangTexts NAME = {` or `LangTexts{`
+LANG_TEXTS_PATTERN = re.compile(r"\bLangTexts(?:\s+\w+\s*=)?\s*{")
+
+
+def strip_comments(source):
+    result = []
+    i = 0
+    in_string = False
+    while i < len(source):
+        c = source[i]
+        if in_string:
+            result.append(c)
+            if c == "\\":
+                result.append(source[i + 1])
+                i += 1
+            elif c == '"':
+                in_string = False
+        elif source.startswith("//", i):
+            while i < len(source) and source[i] != "\n":
+                i += 1
+            continue
+        elif source.startswith("/*", i):
+            end = source.index("*/", i) + 2
+            # keep the newlines, so that the reported line numbers are right
+            result.append("\n" * source.count("\n", i, end))
+            i = end
+            continue
+        else:
+            if c == '"':
+                in_string = True
+            result.append(c)
+        i += 1
+    return "".join(result)
+
+
+def read_languages(settings_path):
+    with open(settings_path, encoding="utf-8") as f:
+        source = strip_comments(f.read())
+
+    enum_body = re.search(r"enum\s+Language\s*{([^}]*)}", source)
+    if enum_body is None:
+        raise ValueError(f"`enum Language` not found in {settings_path}")
+
+    languages = []
+    for member in enum_body.group(1).split(","):
+        name = member.split("=")[0].strip()
+        if name == "TOTAL_LANGUAGES":
+            break
+        if name:
+            languages.append(name)
+    return languages
+
+
+def line_of(source, pos):
+    return source.count("\n", 0, pos) + 1
+
+
+def unescape(literal):
+    if "\\" in literal:
+        literal = literal.encode("latin-1", "backslashreplace").decode("unicode_escape").encode("latin-1").decode()
+    return literal
+
+
+def parse_initializer(source, begin):
+    """
+    Parse the `LangTexts` initializer body which starts at `begin`, right after its `{`.
+    Each element should be one or more adjacent string literals, which are concatenated.
+
+    Returns the texts, and the position right after the closing `}`.
+    """
+    texts = []
+    element = None
+    pos = begin
+    while True:
+        match = STRING_PATTERN.match(source, pos)
+        if match is not None:
+            element = (element or "") + unescape(match.group(1))
+            pos = match.end()
+            continue
+
+        c = source[pos] if pos < len(source) else ""
+        if c.isspace():
+            pos += 1
+        elif c == ",":
+            if element is None:
+                raise ValueError(f"line {line_of(source, pos)}: empty element in a `LangTexts` initializer")
+            texts.append(element)
+            element = None
+            pos += 1
+        elif c == "}":
+            # trailing comma leaves no element
+            if element is not None:
+                texts.append(element)
+            return texts, pos + 1
+        else:
+            found = repr(c) if c else "end of file"
+            raise ValueError(f"line {line_of(source, pos)}: unexpected {found} in a `LangTexts` initializer, "
+                             "which should only have string literals")
+
+
+def read_lang_texts(texts_path, languages_count):
+    with open(texts_path, encoding="utf-8") as f:
+        source = strip_comments(f.read())
+    source = re.sub(r"^[ \t]*#.*$", "", source, flags=re.MULTILINE)
+
+    lang_texts = []
+    parsed_ranges = []
+    for match in LANG_TEXTS_PATTERN.finditer(source):
+        texts, end = parse_initializer(source, match.end())
+        if len(texts) != languages_count:
+            raise ValueError(f"line {line_of(source, match.start())}: `LangTexts` initializer has {len(texts)} texts, "
+                             f"instead of {languages_count} languages")
+        lang_texts.append(texts)
+        parsed_ranges.append((match.end(), end))
+
+    for match in STRING_PATTERN.finditer(source):
+        if not any(begin <= match.start() < end for begin, end in parsed_ranges):
+            raise ValueError(f"line {line_of(source, match.start())}: string literal \"{match.group(1)}\" "
+                             "is not in a `LangTexts` initializer")
+
+    return lang_texts
+
+
+def encode(text, glyph_ids):
+    ids = []
+    i = 0
+    while i < len(text):
+        if text.startswith("{}", i):
+            ids.append(PLACEHOLDER_ID)
+            i += 2
+            continue
+        char = text[i]
+        if char not in glyph_ids:
+            glyph_ids[char] = len(glyph_ids)
+        ids.append(glyph_ids[char])
+        i += 1
+    return ids
+
+
+def cpp_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def generate(languages, lang_texts, glyph_tiles):
+    lines = []
+    report = []
+    max_glyphs = 0
+
+    for lang_idx, lang in enumerate(languages):
+        glyph_ids = {" ": SPACE_ID}
+        texts = list(dict.fromkeys(entry[lang_idx] for entry in lang_texts))
+
+        runs = []
+        ids = []
+        for text in texts:
+            encoded = encode(text, glyph_ids)
+            runs.append((text, len(ids), len(encoded)))
+            ids.extend(encoded)
+
+        if len(glyph_ids) > MAX_GLYPHS:
+            raise ValueError(f"{lang} uses {len(glyph_ids)} glyphs, more than {MAX_GLYPHS}")
+        if len(ids) > 0xFFFF:
+            raise ValueError(f"{lang} texts are too long ({len(ids)} glyphs)")
+
+        max_glyphs = max(max_glyphs, len(glyph_ids))
+
+        glyphs = sorted(glyph_ids, key=glyph_ids.get)
+        lines.append(f"inline constexpr bn::string_view {lang}_GLYPHS[] = {{")
+        lines.append("    " + ", ".join(cpp_string(glyph) for glyph in glyphs) + ",")
+        lines.append("};")
+        lines.append(f"inline constexpr u8 {lang}_IDS[] = {{")
+        for run_start in range(0, len(ids), 24):
+            lines.append("    " + ", ".join(str(glyph_id) for glyph_id in ids[run_start : run_start + 24]) + ",")
+        lines.append("};")
+        lines.append(f"inline constexpr GlyphRun {lang}_RUNS[] = {{")
+        for text, offset, length in runs:
+            lines.append(f"    {{{cpp_string(text)}, {offset}, {length}}},")
+        lines.append("};")
+        lines.append("")
+
+        vram_bytes = (len(glyph_ids) - 1) * glyph_tiles * TILE_BYTES
+        report.append(f"    {lang}: {len(glyph_ids) - 1} glyphs, {len(ids)} glyph ids in {len(runs)} texts, "
+                      f"{vram_bytes} bytes of VRAM to hold every glyph ({glyph_tiles} tiles per glyph)")
+
+    def per_lang(suffix):
+        return ", ".join(f"{lang}_{suffix}" for lang in languages)
+
+    body = "\n".join(lines)
+    header = f"""// Generated by tools/texts_glyphs_tool.py from texts.hpp. DO NOT EDIT.
+
+#ifndef TEXTS_GLYPHS_H
+#define TEXTS_GLYPHS_H
+
+#include "bn_array.h"
+#include "bn_span.h"
+#include "bn_string_view.h"
+
+#include "typedefs.hpp"
+
+namespace mp::texts::glyphs
+{{
+
+inline constexpr s32 LANGUAGES_COUNT = {len(languages)};
+inline constexpr s32 MAX_GLYPHS = {max_glyphs};
+
+inline constexpr u8 SPACE_ID = {SPACE_ID};
+inline constexpr u8 PLACEHOLDER_ID = {PLACEHOLDER_ID};
+
+struct GlyphRun
+{{
+    bn::string_view text;
+    u16 offset;
+    u16 length;
+}};
+
+{body}
+inline constexpr bn::array<bn::span<const bn::string_view>, LANGUAGES_COUNT> GLYPHS = {{{per_lang("GLYPHS")}}};
+inline constexpr bn::array<bn::span<const u8>, LANGUAGES_COUNT> IDS = {{{per_lang("IDS")}}};
+inline constexpr bn::array<bn::span<const GlyphRun>, LANGUAGES_COUNT> RUNS = {{{per_lang("RUNS")}}};
+
+/**
+ * @brief Find the glyph ids of a text in `texts.hpp`.
+ * Meant to be evaluated at compile time, as it's a linear search with string comparisons.
+ */
+constexpr auto find(s32 lang, const bn::string_view& text) -> bn::span<const u8>
+{{
+    for (const GlyphRun& run : RUNS[lang])
+        if (run.text == text)
+            return IDS[lang].subspan(run.offset, run.length);
+
+    return {{}};
+}}
+
+}} // namespace mp::texts::glyphs
+
+#endif
+"""
+    return header, report
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Dense glyph ids generator for texts.hpp")
+    parser.add_argument("--build", required=True, help="build folder path")
+    parser.add_argument("--texts", required=True, help="texts header path")
+    parser.add_argument("--settings", required=True, help="header path which has `enum Language`")
+    parser.add_argument("--glyph-tiles", type=int, default=2, help="8x8 tiles per glyph, for the VRAM report")
+    args = parser.parse_args()
+
+    languages = read_languages(args.settings)
+    lang_texts = read_lang_texts(args.texts, len(languages))
+    header, report = generate(languages, lang_texts, args.glyph_tiles)
+
+    os.makedirs(args.build, exist_ok=True)
+    header_path = os.path.join(args.build, HEADER_NAME)
+
+    # don't touch the header if it's unchanged, to avoid rebuilding everything.
+    if os.path.isfile(header_path):
+        with open(header_path, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+
+    with open(header_path, "w", encoding="utf-8") as f:
+        f.write(header)
+
+    print(f"{HEADER_NAME} generated:")
+    for line in report:
+        print(line)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except (OSError, ValueError) as ex:
+        sys.exit(f"texts_glyphs_tool error: {ex}")